@@ -0,0 +1,101 @@
+#ifndef CRYPTOGRAPHY1_BENCHDATA_H
+#define CRYPTOGRAPHY1_BENCHDATA_H
+
+#include "Types.h"
+#include "GF2Polynomial.h"
+#include <algorithm>
+#include <random>
+
+/**
+ * @brief Deterministic inputs shared by the benchmarks, so runs on different commits measure the same work.
+ */
+namespace BenchData {
+
+/**
+ * @brief The key used to build Vigenère ciphertexts.
+ */
+inline const String vigenere_key = "cryptography";
+
+/**
+ * @brief Builds English plaintext of the requested length by repeating a fixed passage.
+ * @param length The number of characters.
+ * @return Lowercase letters, without spaces or punctuation.
+ */
+inline String englishText(datatype_size length) {
+    static const String passage =
+        "itwasthebestoftimesitwastheworstoftimesitwastheageofwisdomitwastheageoffoolishness"
+        "itwastheepochofbeliefitwastheepochofincredulityitwastheseasonoflightitwastheseason"
+        "ofdarknessitwasthespringofhopeitwasthewinterofdespairwehadeverythingbeforeuswehad"
+        "nothingbeforeusweewereallgoingdirecttoheavenwewereallgoingdirecttheotherway";
+    String text;
+    text.reserve(length);
+    while (text.size() < length) {
+        text.append(passage, 0, std::min(passage.size(), length - text.size()));
+    }
+    return text;
+}
+
+/**
+ * @brief Builds an uppercase Vigenère ciphertext of English text under `vigenere_key`.
+ * @param length The number of characters.
+ * @return The ciphertext.
+ */
+inline String vigenereCiphertext(datatype_size length) {
+    String text = englishText(length);
+    for (datatype_size i = 0; i < text.size(); ++i) {
+        const int32 shift = vigenere_key[i % vigenere_key.size()] - 'a';
+        text[i] = static_cast<char>('A' + (text[i] - 'a' + shift) % 26);
+    }
+    return text;
+}
+
+/**
+ * @brief Builds pseudo-random bytes from a fixed seed.
+ * @param length The number of bytes.
+ * @param seed The generator seed.
+ * @return The bytes.
+ */
+inline String randomBytes(datatype_size length, uint32 seed = 1) {
+    std::mt19937 generator(seed);
+    String bytes(length, '\0');
+    for (char& byte : bytes) {
+        byte = static_cast<char>(generator());
+    }
+    return bytes;
+}
+
+/**
+ * @brief Builds pseudo-random integer coefficients in [-16, 16] from a fixed seed.
+ * @param count The number of coefficients.
+ * @param seed The generator seed.
+ * @return The coefficients. The first one is never zero.
+ */
+inline Vector(int32) randomCoefficients(datatype_size count, uint32 seed = 1) {
+    std::mt19937 generator(seed);
+    Vector(int32) coeffs(count);
+    for (int32& coeff : coeffs) {
+        coeff = static_cast<int32>(generator() % 33) - 16;
+    }
+    if (!coeffs.empty() && coeffs[0] == 0) {
+        coeffs[0] = 1;
+    }
+    return coeffs;
+}
+
+/**
+ * @brief Finds the lexicographically smallest primitive polynomial of a degree.
+ * @param degree The degree, between 2 and 63.
+ * @return The polynomial.
+ */
+inline GF2Polynomial firstPrimitive(uint32 degree) {
+    for (uint64 middle = 0;; ++middle) {
+        const GF2Polynomial candidate((1ULL << degree) | (middle << 1) | 1);
+        if (candidate.isPrimitive()) {
+            return candidate;
+        }
+    }
+}
+
+} // namespace BenchData
+
+#endif //CRYPTOGRAPHY1_BENCHDATA_H
@@ -0,0 +1,405 @@
+#include "AeadContext.h"
+#include "AesContext.h"
+#include "AvalancheAnalysis.h"
+#include "BatchCracker.h"
+#include "BenchData.h"
+#include "CipherSolver.h"
+#include "Crypto.h"
+#include "FrequencyAnalysis.h"
+#include "Friedman.h"
+#include "LanguageModel.h"
+#include "ParallelAes.h"
+#include "StreamingKasiski.h"
+#include "ThreadPool.h"
+#include "Utils.h"
+#include "Vigenere.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+namespace {
+
+constexpr int64 min_ciphertext_length = 1 << 10;
+constexpr int64 max_ciphertext_length = 1 << 16;
+constexpr int64 min_aes_buffer = 16;
+constexpr int64 max_aes_buffer = 1 << 20;
+
+void BM_FindKeyLengthKasiski(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::findKeyLengthKasiski(ciphertext, 3));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindKeyLengthKasiski)->RangeMultiplier(4)->Range(min_ciphertext_length, max_ciphertext_length);
+
+void BM_StreamingKasiski(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    constexpr datatype_size chunk_size = 1 << 12;
+    for (auto _ : state) {
+        StreamingKasiski kasiski(3);
+        for (datatype_size offset = 0; offset < ciphertext.size(); offset += chunk_size) {
+            kasiski.update(ciphertext.data() + offset, std::min(chunk_size, ciphertext.size() - offset));
+        }
+        benchmark::DoNotOptimize(kasiski.estimateKeyLength());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StreamingKasiski)->RangeMultiplier(8)->Range(min_ciphertext_length, 1 << 22);
+
+void BM_FindKeyLengthFriedman(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    const uint32 max_key_length = state.range(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::findKeyLengthFriedman(ciphertext, max_key_length));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindKeyLengthFriedman)
+    ->ArgsProduct({benchmark::CreateRange(min_ciphertext_length, max_ciphertext_length, 4), {20, 100}});
+
+void BM_RankKeyLengthsFriedman(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    const uint32 max_key_length = state.range(1);
+    ThreadPool pool;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Friedman::rankKeyLengths(ciphertext, max_key_length, pool));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RankKeyLengthsFriedman)
+    ->ArgsProduct({benchmark::CreateRange(min_ciphertext_length, 1 << 20, 16), {20, 500}})
+    ->UseRealTime();
+
+void BM_GetKeyWithFrequencyAnalysis(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::getKeyWithFrequencyAnalysis(ciphertext, BenchData::vigenere_key.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetKeyWithFrequencyAnalysis)->RangeMultiplier(4)->Range(min_ciphertext_length, max_ciphertext_length);
+
+void BM_BatchCrack(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    constexpr uint64 batch_size = 256;
+    ThreadPool pool;
+    BatchCracker cracker(pool);
+    for (auto _ : state) {
+        uint64 remaining = batch_size;
+        cracker.run([&](CrackJob& job) {
+            job.ciphertext = ciphertext;
+            return remaining-- > 0;
+        }, [](const CrackResult& result) {
+            benchmark::DoNotOptimize(result.key.data());
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+    state.SetBytesProcessed(state.iterations() * batch_size * state.range(0));
+}
+BENCHMARK(BM_BatchCrack)->RangeMultiplier(4)->Range(min_ciphertext_length, max_ciphertext_length)->UseRealTime();
+
+void BM_ScoreCandidateKey(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(min_ciphertext_length);
+    const FrequencyAnalysis analysis;
+    const Vector(float64) column_scores = analysis.scoreColumns(ciphertext, BenchData::vigenere_key.size());
+    Vector(uint8) shifts(BenchData::vigenere_key.size(), 0);
+    uint64 candidate = 0;
+    for (auto _ : state) {
+        shifts[candidate % shifts.size()] = candidate % analysis.getAlphabetSize();
+        benchmark::DoNotOptimize(analysis.scoreKey(column_scores, shifts.data()));
+        ++candidate;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ScoreCandidateKey);
+
+void BM_QuadgramFitness(benchmark::State& state) {
+    const String corpus = BenchData::englishText(1 << 20);
+    Vector(uint8) indices(corpus.size());
+    Utils::convertLettersToIndices(corpus.data(), corpus.size(), indices.data());
+    LanguageModelBuilder builder(Utils::english_alphabet_size);
+    builder.addText(indices.data(), indices.size());
+    const LanguageModel model = builder.build();
+
+    indices.resize(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.fitness(indices.data(), indices.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_QuadgramFitness)->RangeMultiplier(4)->Range(min_ciphertext_length, max_ciphertext_length);
+
+void BM_SolveVigenere(benchmark::State& state) {
+    const String corpus = BenchData::englishText(1 << 16);
+    Vector(uint8) indices(corpus.size());
+    Utils::convertLettersToIndices(corpus.data(), corpus.size(), indices.data());
+    LanguageModelBuilder builder(Utils::english_alphabet_size);
+    builder.addText(indices.data(), indices.size());
+    const LanguageModel model = builder.build();
+
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    ThreadPool pool;
+    const SolverOptions options;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            CipherSolver::solveVigenereKey(ciphertext, BenchData::vigenere_key.size(), model, pool, options));
+    }
+    state.SetItemsProcessed(state.iterations() * options.restarts * options.iterations);
+}
+BENCHMARK(BM_SolveVigenere)->RangeMultiplier(4)->Range(64, min_ciphertext_length)->UseRealTime();
+
+void BM_VigenereDecipher(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::vigenereDecipher(ciphertext, BenchData::vigenere_key));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VigenereDecipher)->RangeMultiplier(4)->Range(min_ciphertext_length, max_ciphertext_length);
+
+void BM_VigenereDecipherInto(benchmark::State& state) {
+    const String ciphertext = BenchData::vigenereCiphertext(state.range(0));
+    const Vigenere cipher(BenchData::vigenere_key);
+    String plaintext(ciphertext.size(), '\0');
+    for (auto _ : state) {
+        cipher.decipher(ciphertext.data(), ciphertext.size(), plaintext.data());
+        benchmark::DoNotOptimize(plaintext.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VigenereDecipherInto)->RangeMultiplier(8)->Range(min_ciphertext_length, 1 << 22);
+
+void BM_VigenereEncipher(benchmark::State& state) {
+    const String plaintext = BenchData::englishText(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::vigenereEncipher(plaintext, BenchData::vigenere_key));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VigenereEncipher)->RangeMultiplier(4)->Range(min_ciphertext_length, max_ciphertext_length);
+
+void BM_Encrypt16Bit(benchmark::State& state) {
+    uint16 message = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::decrypt16bit(Crypto::encrypt16bit(message++)));
+    }
+}
+BENCHMARK(BM_Encrypt16Bit);
+
+void BM_GenerateOTPKey(benchmark::State& state) {
+    const String charset = "abcdefghijklmnopqrstuvwxyz .,!'";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::generateOTPKey(state.range(0), charset));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateOTPKey)->RangeMultiplier(4)->Range(min_ciphertext_length, max_ciphertext_length);
+
+void BM_EncryptOTP(benchmark::State& state) {
+    const String plaintext = BenchData::englishText(state.range(0));
+    const String key = BenchData::randomBytes(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::decrypt(Crypto::encrypt(plaintext, key), key));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncryptOTP)->RangeMultiplier(4)->Range(min_ciphertext_length, max_ciphertext_length);
+
+// items_per_second is flipped-input pairs per second; each pair costs one AES block encryption.
+void BM_AvalancheAes(benchmark::State& state) {
+    const String key = BenchData::randomBytes(16, 3);
+    ThreadPool pool;
+    AvalancheOptions options;
+    options.trials = state.range(0);
+    const AvalancheAnalysis::CipherFactory make_cipher = [&key]() -> AvalancheAnalysis::Cipher {
+        auto block = std::make_shared<AesContext>(AesMode::ECB, key);
+        block->setPadding(false);
+        return [block](const uint8* input, uint8* output) {
+            block->process(input, AesContext::block_size, output);
+        };
+    };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            AvalancheAnalysis::run(make_cipher, AesContext::block_size, AesContext::block_size, pool, options));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * AesContext::block_size * 8);
+}
+BENCHMARK(BM_AvalancheAes)->RangeMultiplier(8)->Range(64, 4096)->UseRealTime();
+
+void BM_CountDiffBits(benchmark::State& state) {
+    const String lhs = BenchData::randomBytes(state.range(0), 1);
+    const String rhs = BenchData::randomBytes(state.range(0), 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::countDiffBits(lhs, rhs));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CountDiffBits)->RangeMultiplier(8)->Range(min_aes_buffer, max_aes_buffer);
+
+void BM_EncryptECB(benchmark::State& state) {
+    const String key = BenchData::randomBytes(16, 3);
+    const String plaintext = BenchData::randomBytes(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::encryptECB(key, plaintext));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncryptECB)->RangeMultiplier(8)->Range(min_aes_buffer, max_aes_buffer);
+
+void BM_EncryptCBC(benchmark::State& state) {
+    const String key = BenchData::randomBytes(16, 3);
+    const String iv = BenchData::randomBytes(16, 4);
+    const String plaintext = BenchData::randomBytes(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::encryptCBC(key, iv, plaintext));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncryptCBC)->RangeMultiplier(8)->Range(min_aes_buffer, max_aes_buffer);
+
+void BM_AesContextEncryptECB(benchmark::State& state) {
+    AesContext context(AesMode::ECB, BenchData::randomBytes(16, 3));
+    const String plaintext = BenchData::randomBytes(state.range(0));
+    String ciphertext(AesContext::getCiphertextSize(plaintext.size()), '\0');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.process(reinterpret_cast<const uint8*>(plaintext.data()), plaintext.size(),
+                                                 reinterpret_cast<uint8*>(ciphertext.data())));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AesContextEncryptECB)->RangeMultiplier(8)->Range(min_aes_buffer, max_aes_buffer);
+
+void BM_AesContextEncryptCBC(benchmark::State& state) {
+    AesContext context(AesMode::CBC, BenchData::randomBytes(16, 3), BenchData::randomBytes(16, 4));
+    const String plaintext = BenchData::randomBytes(state.range(0));
+    String ciphertext(AesContext::getCiphertextSize(plaintext.size()), '\0');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.process(reinterpret_cast<const uint8*>(plaintext.data()), plaintext.size(),
+                                                 reinterpret_cast<uint8*>(ciphertext.data())));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AesContextEncryptCBC)->RangeMultiplier(8)->Range(min_aes_buffer, max_aes_buffer);
+
+void BM_AesContextDecryptCBC(benchmark::State& state) {
+    const String key = BenchData::randomBytes(16, 3);
+    const String iv = BenchData::randomBytes(16, 4);
+    const String ciphertext = Crypto::encryptCBC(key, iv, BenchData::randomBytes(state.range(0)));
+    AesContext context(AesMode::CBC, key, iv, AesDirection::Decrypt);
+    String plaintext(context.getOutputBound(ciphertext.size()), '\0');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.process(reinterpret_cast<const uint8*>(ciphertext.data()), ciphertext.size(),
+                                                 reinterpret_cast<uint8*>(plaintext.data())));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AesContextDecryptCBC)->RangeMultiplier(8)->Range(min_aes_buffer, max_aes_buffer);
+
+// Streams 1 MiB through update() in chunks of the given size, as processFile does with its buffers.
+void BM_AesStreamCTR(benchmark::State& state) {
+    constexpr datatype_size total = 1 << 20;
+    const datatype_size chunk = state.range(0);
+    AesContext context(AesMode::CTR, BenchData::randomBytes(16, 3), BenchData::randomBytes(16, 4));
+    const String plaintext = BenchData::randomBytes(total);
+    Vector(uint8) ciphertext(total);
+    const uint8* input = reinterpret_cast<const uint8*>(plaintext.data());
+    for (auto _ : state) {
+        context.reset();
+        for (datatype_size offset = 0; offset < total; offset += chunk) {
+            context.update({input + offset, chunk}, {ciphertext.data() + offset, chunk});
+        }
+        benchmark::DoNotOptimize(context.finalize({}));
+    }
+    state.SetBytesProcessed(state.iterations() * total);
+}
+BENCHMARK(BM_AesStreamCTR)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+void BM_ParallelAesCTR(benchmark::State& state) {
+    const String key = BenchData::randomBytes(16, 3);
+    const String iv = BenchData::randomBytes(16, 4);
+    const String plaintext = BenchData::randomBytes(state.range(0));
+    Vector(uint8) ciphertext(plaintext.size());
+    ThreadPool pool;
+    for (auto _ : state) {
+        ParallelAes::ctr(key, iv, {reinterpret_cast<const uint8*>(plaintext.data()), plaintext.size()}, ciphertext,
+                         pool);
+        benchmark::DoNotOptimize(ciphertext.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelAesCTR)->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->UseRealTime();
+
+void BM_ParallelAesDecryptCBC(benchmark::State& state) {
+    const String key = BenchData::randomBytes(16, 3);
+    const String iv = BenchData::randomBytes(16, 4);
+    const String ciphertext = Crypto::encryptCBC(key, iv, BenchData::randomBytes(state.range(0)));
+    Vector(uint8) plaintext(ciphertext.size());
+    ThreadPool pool;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ParallelAes::decryptCBC(
+            key, iv, {reinterpret_cast<const uint8*>(ciphertext.data()), ciphertext.size()}, plaintext, pool));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelAesDecryptCBC)->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->UseRealTime();
+
+String aeadKey(AeadAlgorithm algorithm) {
+    return BenchData::randomBytes(AeadContext::getKeySize(algorithm), 3);
+}
+
+// One message per iteration, so items_per_second is messages per second.
+void BM_AeadSeal(benchmark::State& state, AeadAlgorithm algorithm) {
+    AeadContext context(algorithm, aeadKey(algorithm));
+    const String nonce = BenchData::randomBytes(AeadContext::nonce_size, 4);
+    const String plaintext = BenchData::randomBytes(state.range(0));
+    Vector(uint8) sealed(plaintext.size() + AeadContext::tag_size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.seal({reinterpret_cast<const uint8*>(nonce.data()), nonce.size()}, {},
+                                              {reinterpret_cast<const uint8*>(plaintext.data()), plaintext.size()},
+                                              sealed));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_AeadSeal, aes_128_gcm, AeadAlgorithm::AES_128_GCM)->RangeMultiplier(8)->Range(16, 16384);
+BENCHMARK_CAPTURE(BM_AeadSeal, chacha20_poly1305, AeadAlgorithm::CHACHA20_POLY1305)
+    ->RangeMultiplier(8)->Range(16, 16384);
+
+void BM_AeadOpen(benchmark::State& state, AeadAlgorithm algorithm) {
+    AeadContext context(algorithm, aeadKey(algorithm));
+    const String nonce = BenchData::randomBytes(AeadContext::nonce_size, 4);
+    const String sealed = context.seal(nonce, BenchData::randomBytes(state.range(0)));
+    Vector(uint8) plaintext(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.open({reinterpret_cast<const uint8*>(nonce.data()), nonce.size()}, {},
+                                              {reinterpret_cast<const uint8*>(sealed.data()), sealed.size()},
+                                              plaintext));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_AeadOpen, aes_128_gcm, AeadAlgorithm::AES_128_GCM)->RangeMultiplier(8)->Range(16, 16384);
+BENCHMARK_CAPTURE(BM_AeadOpen, chacha20_poly1305, AeadAlgorithm::CHACHA20_POLY1305)
+    ->RangeMultiplier(8)->Range(16, 16384);
+
+// Seals 1024 messages of the given size per iteration into one arena; items_per_second is messages per second.
+void BM_AeadSealBatch(benchmark::State& state, AeadAlgorithm algorithm) {
+    constexpr datatype_size batch_size = 1024;
+    AeadContext context(algorithm, aeadKey(algorithm));
+    const String nonce = BenchData::randomBytes(AeadContext::nonce_size, 4);
+    const String payload = BenchData::randomBytes(batch_size * state.range(0));
+    Vector(std::string_view) messages;
+    for (datatype_size i = 0; i < batch_size; ++i) {
+        messages.push_back(std::string_view(payload).substr(i * state.range(0), state.range(0)));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.sealBatch(nonce, messages));
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK_CAPTURE(BM_AeadSealBatch, aes_128_gcm, AeadAlgorithm::AES_128_GCM)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_CAPTURE(BM_AeadSealBatch, chacha20_poly1305, AeadAlgorithm::CHACHA20_POLY1305)
+    ->RangeMultiplier(4)->Range(16, 1024);
+
+} // namespace
@@ -0,0 +1,115 @@
+#include "BenchData.h"
+#include "GF2Polynomial.h"
+#include "ModPolynomial.h"
+#include "Polynomial.h"
+#include "PrimitivePolynomialSearch.h"
+#include "ThreadPool.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void BM_PolynomialMultiply(benchmark::State& state) {
+    const uint32 degree = state.range(0);
+    const Polynomial a(degree, BenchData::randomCoefficients(degree + 1, 1));
+    const Polynomial b(degree, BenchData::randomCoefficients(degree + 1, 2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PolynomialMultiply)->RangeMultiplier(4)->Range(16, 1 << 14)->Complexity();
+
+void BM_PolynomialDivide(benchmark::State& state) {
+    const uint32 degree = state.range(0);
+    const uint32 divisor_degree = degree / 2;
+    Vector(int32) divisor_coeffs = BenchData::randomCoefficients(divisor_degree + 1, 2);
+    divisor_coeffs[0] = 1;
+    const Polynomial a(degree, BenchData::randomCoefficients(degree + 1, 1));
+    const Polynomial b(divisor_degree, divisor_coeffs);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a / b);
+        benchmark::DoNotOptimize(a % b);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PolynomialDivide)->RangeMultiplier(4)->Range(16, 1 << 14)->Complexity();
+
+void BM_ModPolynomialMultiply(benchmark::State& state) {
+    using Field = StaticField<998244353>;
+    Vector(uint64) lhs(state.range(0) + 1), rhs(state.range(0) + 1);
+    std::mt19937_64 generator(1);
+    for (datatype_size i = 0; i < lhs.size(); ++i) {
+        lhs[i] = generator();
+        rhs[i] = generator();
+    }
+    const ModPolynomial<Field> a(lhs), b(rhs);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+}
+BENCHMARK(BM_ModPolynomialMultiply)->RangeMultiplier(4)->Range(16, 1 << 12);
+
+void BM_GF2Multiply(benchmark::State& state) {
+    const uint32 degree = state.range(0);
+    const Polynomial a = (GF2Polynomial::monomial(degree) + GF2Polynomial(0x2d)).toPolynomial();
+    const Polynomial b = (GF2Polynomial::monomial(degree) + GF2Polynomial(0x5b)).toPolynomial();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Polynomial::gf2Multiply(a, b));
+    }
+}
+BENCHMARK(BM_GF2Multiply)->RangeMultiplier(4)->Range(16, 1 << 12);
+
+void BM_GF2Mod(benchmark::State& state) {
+    const uint32 degree = state.range(0);
+    const Polynomial a = (GF2Polynomial::monomial(2 * degree) + GF2Polynomial(0x2d)).toPolynomial();
+    const Polynomial b = (GF2Polynomial::monomial(degree) + GF2Polynomial(0x5b)).toPolynomial();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Polynomial::gf2Mod(a, b));
+    }
+}
+BENCHMARK(BM_GF2Mod)->RangeMultiplier(4)->Range(16, 1 << 12);
+
+void BM_GF2PolynomialMultiply(benchmark::State& state) {
+    Vector(uint64) lhs(state.range(0)), rhs(state.range(0));
+    std::mt19937_64 generator(1);
+    for (datatype_size i = 0; i < lhs.size(); ++i) {
+        lhs[i] = generator();
+        rhs[i] = generator();
+    }
+    const GF2Polynomial a = GF2Polynomial::fromWords(lhs);
+    const GF2Polynomial b = GF2Polynomial::fromWords(rhs);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2 * sizeof(uint64));
+}
+BENCHMARK(BM_GF2PolynomialMultiply)->RangeMultiplier(4)->Range(1, 1 << 10);
+
+void BM_GF2IsIrreducible(benchmark::State& state) {
+    const Polynomial polynomial = BenchData::firstPrimitive(state.range(0)).toPolynomial();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(polynomial.gf2IsIrreducible());
+    }
+}
+BENCHMARK(BM_GF2IsIrreducible)->DenseRange(8, 56, 16)->Arg(63);
+
+void BM_GF2IsPrimitive(benchmark::State& state) {
+    const Polynomial polynomial = BenchData::firstPrimitive(state.range(0)).toPolynomial();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(polynomial.gf2IsPrimitive());
+    }
+}
+BENCHMARK(BM_GF2IsPrimitive)->DenseRange(8, 56, 16)->Arg(63);
+
+void BM_PrimitivePolynomialSearch(benchmark::State& state) {
+    ThreadPool pool;
+    PrimitiveSearchOptions options;
+    options.degree = state.range(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PrimitivePolynomialSearch::enumerate(options, pool, [](const GF2Polynomial&) {}));
+    }
+    state.SetItemsProcessed(state.iterations() * (1LL << (state.range(0) - 1)));
+}
+BENCHMARK(BM_PrimitivePolynomialSearch)->DenseRange(12, 20, 4)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,60 @@
+#include "BenchData.h"
+#include "Utils.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void BM_ConvertCharToInt(benchmark::State& state) {
+    const String text = BenchData::vigenereCiphertext(state.range(0));
+    for (auto _ : state) {
+        int32 sum = 0;
+        for (char c : text) {
+            sum += Utils::convertCharToInt(c);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertCharToInt)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+void BM_ToBitString(benchmark::State& state) {
+    const String bytes = BenchData::randomBytes(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Utils::toBitString(bytes));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ToBitString)->RangeMultiplier(8)->Range(16, 1 << 16);
+
+void BM_TransposeVectorString(benchmark::State& state) {
+    const String text = BenchData::englishText(state.range(0));
+    const datatype_size row_length = 64;
+    Vector(String) rows;
+    for (datatype_size offset = 0; offset < text.size(); offset += row_length) {
+        rows.push_back(text.substr(offset, row_length));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Utils::transposeVectorString(rows));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransposeVectorString)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+void BM_GenerateRandomString(benchmark::State& state) {
+    const String charset = "abcdefghijklmnopqrstuvwxyz";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Utils::generateRandomString(state.range(0), charset));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenerateRandomString)->RangeMultiplier(8)->Range(16, 1 << 16);
+
+void BM_IntToBits(benchmark::State& state) {
+    int32 value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Utils::intToBits(value++));
+    }
+}
+BENCHMARK(BM_IntToBits);
+
+} // namespace
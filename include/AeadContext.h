@@ -0,0 +1,173 @@
+#ifndef CRYPTOGRAPHY1_AEADCONTEXT_H
+#define CRYPTOGRAPHY1_AEADCONTEXT_H
+
+#include "Types.h"
+#include <memory>
+#include <span>
+#include <string_view>
+
+typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+
+/**
+ * @brief The authenticated encryption algorithms an `AeadContext` supports.
+ */
+enum class AeadAlgorithm {
+    AES_128_GCM,      ///< AES-128 in Galois/counter mode, 16-byte key.
+    CHACHA20_POLY1305 ///< ChaCha20 with the Poly1305 authenticator (RFC 8439), 32-byte key.
+};
+
+/**
+ * @struct AeadBatch
+ * @brief Messages sealed by `AeadContext::sealBatch`, stored back to back in one buffer.
+ */
+struct AeadBatch {
+    Vector(uint8) arena;            ///< Every sealed message, ciphertext followed by tag, one after the other.
+    Vector(datatype_size) offsets;  ///< Message i is arena[offsets[i], offsets[i + 1]); one more entry than messages.
+
+    /**
+     * @brief Gets the number of messages.
+     */
+    datatype_size size() const;
+
+    /**
+     * @brief Gets a sealed message.
+     * @param index The message index, less than `size()`.
+     * @return The ciphertext followed by the tag.
+     */
+    std::span<const uint8> getMessage(datatype_size index) const;
+};
+
+/**
+ * @class AeadContext
+ * @brief Authenticated encryption with associated data, with the key set up once for many messages.
+ * @details Sealing encrypts a message and appends a 16-byte tag that authenticates the ciphertext and any
+ *          associated data; opening checks the tag before returning the plaintext. Like `AesContext`, the
+ *          OpenSSL context and key are prepared once, in the constructor, and each message only restarts the
+ *          context with its nonce, which keeps the cost of small messages low.
+ *
+ *          A nonce must never be used twice with the same key. `sealBatch` derives one nonce per message from a
+ *          base nonce, by XORing the message index into its last 8 bytes, as TLS 1.3 does for records.
+ *
+ *          The OpenSSL context is owned and freed on destruction. A context is not safe to use from several
+ *          threads at once; give each thread its own.
+ */
+class AeadContext {
+public:
+    /**
+     * @brief The nonce size in bytes, for both algorithms.
+     */
+    static constexpr datatype_size nonce_size = 12;
+
+    /**
+     * @brief The authentication tag size in bytes.
+     */
+    static constexpr datatype_size tag_size = 16;
+
+    /**
+     * @brief Creates a context and sets the key.
+     * @param algorithm The algorithm.
+     * @param key The key, 16 bytes for AES-128-GCM or 32 bytes for ChaCha20-Poly1305.
+     * @throws std::length_error If the key has the wrong size.
+     * @throws std::runtime_error If OpenSSL fails to create or initialize the context.
+     */
+    AeadContext(AeadAlgorithm algorithm, const String& key);
+
+    ~AeadContext();
+
+    AeadContext(AeadContext&& other) noexcept;
+    AeadContext& operator=(AeadContext&& other) noexcept;
+    AeadContext(const AeadContext&) = delete;
+    AeadContext& operator=(const AeadContext&) = delete;
+
+    /**
+     * @brief Gets the algorithm.
+     */
+    AeadAlgorithm getAlgorithm() const;
+
+    /**
+     * @brief Gets the key size an algorithm needs.
+     */
+    static datatype_size getKeySize(AeadAlgorithm algorithm);
+
+    /**
+     * @brief Encrypts and authenticates a message into a caller-provided buffer.
+     * @param nonce The 12-byte nonce, unique for this key.
+     * @param aad Associated data, authenticated but not encrypted. May be empty.
+     * @param plaintext The message.
+     * @param output The destination, at least `plaintext.size() + tag_size` bytes. Receives the ciphertext
+     *               followed by the tag. May start at `plaintext` but must not overlap it otherwise.
+     * @return The number of bytes written, `plaintext.size() + tag_size`.
+     * @throws std::length_error If the nonce is not 12 bytes.
+     * @throws std::invalid_argument If `output` is too small.
+     * @throws std::runtime_error If OpenSSL fails.
+     */
+    datatype_size seal(std::span<const uint8> nonce, std::span<const uint8> aad, std::span<const uint8> plaintext,
+                       std::span<uint8> output);
+
+    /**
+     * @brief Checks and decrypts a sealed message into a caller-provided buffer.
+     * @param nonce The nonce the message was sealed with.
+     * @param aad The associated data it was sealed with.
+     * @param sealed The ciphertext followed by the tag.
+     * @param output The destination, at least `sealed.size() - tag_size` bytes. May start at `sealed`.
+     * @return The plaintext size.
+     * @throws std::length_error If the nonce is not 12 bytes or `sealed` is shorter than a tag.
+     * @throws std::invalid_argument If `output` is too small.
+     * @throws std::runtime_error If the message, the nonce or the associated data were altered, or OpenSSL fails.
+     *                            The output must then be discarded.
+     */
+    datatype_size open(std::span<const uint8> nonce, std::span<const uint8> aad, std::span<const uint8> sealed,
+                       std::span<uint8> output);
+
+    /**
+     * @brief Encrypts and authenticates a message.
+     * @see seal(std::span<const uint8>, std::span<const uint8>, std::span<const uint8>, std::span<uint8>)
+     * @return The ciphertext followed by the tag.
+     */
+    String seal(const String& nonce, const String& plaintext, const String& aad = "");
+
+    /**
+     * @brief Checks and decrypts a sealed message.
+     * @see open(std::span<const uint8>, std::span<const uint8>, std::span<const uint8>, std::span<uint8>)
+     * @return The plaintext.
+     */
+    String open(const String& nonce, const String& sealed, const String& aad = "");
+
+    /**
+     * @brief Seals many messages into one buffer, with one nonce per message derived from a base nonce.
+     * @param base_nonce The 12-byte base nonce. Message i uses `getBatchNonce(base_nonce, i)`.
+     * @param messages The messages.
+     * @param aad Associated data shared by all messages. May be empty.
+     * @return The sealed messages, allocated once.
+     * @throws std::length_error If the base nonce is not 12 bytes.
+     * @throws std::runtime_error If OpenSSL fails.
+     */
+    AeadBatch sealBatch(const String& base_nonce, const Vector(std::string_view)& messages,
+                        const String& aad = "");
+
+    /**
+     * @brief Gets the nonce `sealBatch` uses for a message.
+     * @param base_nonce The 12-byte base nonce.
+     * @param index The message index.
+     * @return The base nonce with the big-endian index XORed into its last 8 bytes.
+     */
+    static String getBatchNonce(const String& base_nonce, uint64 index);
+
+private:
+    /**
+     * @brief Frees an OpenSSL cipher context.
+     */
+    struct ContextDeleter {
+        void operator()(EVP_CIPHER_CTX* context) const;
+    };
+
+    /**
+     * @brief Restarts the context with a nonce and a direction and feeds it the associated data.
+     */
+    void start(std::span<const uint8> nonce, std::span<const uint8> aad, bool encrypt);
+
+    AeadAlgorithm algorithm;
+    std::unique_ptr<EVP_CIPHER_CTX, ContextDeleter> context;
+};
+
+#endif //CRYPTOGRAPHY1_AEADCONTEXT_H
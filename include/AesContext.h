@@ -0,0 +1,195 @@
+#ifndef CRYPTOGRAPHY1_AESCONTEXT_H
+#define CRYPTOGRAPHY1_AESCONTEXT_H
+
+#include "Types.h"
+#include <memory>
+#include <span>
+
+typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+
+/**
+ * @brief The AES-128 modes an `AesContext` supports.
+ */
+enum class AesMode {
+    ECB, ///< Electronic codebook: every block is encrypted on its own. Padded.
+    CBC, ///< Cipher block chaining: every block is XORed with the previous ciphertext block, the first with the IV. Padded.
+    CTR  ///< Counter: the IV is a 128-bit big-endian counter whose encryptions are XORed with the data. Not padded.
+};
+
+/**
+ * @brief Whether an `AesContext` encrypts or decrypts.
+ */
+enum class AesDirection {
+    Encrypt,
+    Decrypt
+};
+
+/**
+ * @class AesContext
+ * @brief An AES-128 context whose key is expanded once and reused for many messages or one long stream.
+ * @details Creating an `EVP_CIPHER_CTX` and running the key schedule dominates the cost of a short message. This
+ *          class does both once, in the constructor. `reset` only restarts the chaining and padding state from the
+ *          current IV, so the same key can process any number of messages, and `setIv` switches IVs without
+ *          expanding the key again.
+ *
+ *          A message is processed either in one call to `process`, or streamed: `reset`, any number of `update`
+ *          calls with chunks of any size, then `finalize`. ECB and CBC use PKCS#7 padding, as
+ *          `Crypto::encryptECB` and `Crypto::encryptCBC` do, so an encrypting stream writes a final padded block
+ *          and a decrypting stream holds back the last block until `finalize` checks and strips the padding. CTR
+ *          output always has the size of its input.
+ *
+ *          The OpenSSL context is owned and freed on destruction, including when an error is thrown. A context
+ *          is not safe to use from several threads at once; give each thread its own.
+ */
+class AesContext {
+public:
+    /**
+     * @brief The AES block size in bytes.
+     */
+    static constexpr datatype_size block_size = 16;
+
+    /**
+     * @brief The AES-128 key size in bytes.
+     */
+    static constexpr datatype_size key_size = 16;
+
+    /**
+     * @brief The default size of each of the buffers `processFile` uses.
+     */
+    static constexpr datatype_size default_file_buffer_size = 1 << 20;
+
+    /**
+     * @brief Creates a context and expands the key.
+     * @param mode The block cipher mode.
+     * @param key The 16-byte key.
+     * @param iv The 16-byte IV for CBC, or initial counter block for CTR. Ignored for ECB; empty means all zeros.
+     * @param direction Whether the context encrypts or decrypts.
+     * @throws std::length_error If the key or a non-empty IV has the wrong size.
+     * @throws std::runtime_error If OpenSSL fails to create or initialize the context.
+     */
+    AesContext(AesMode mode, const String& key, const String& iv = "",
+               AesDirection direction = AesDirection::Encrypt);
+
+    ~AesContext();
+
+    AesContext(AesContext&& other) noexcept;
+    AesContext& operator=(AesContext&& other) noexcept;
+    AesContext(const AesContext&) = delete;
+    AesContext& operator=(const AesContext&) = delete;
+
+    /**
+     * @brief Gets the block cipher mode.
+     */
+    AesMode getMode() const;
+
+    /**
+     * @brief Gets whether the context encrypts or decrypts.
+     */
+    AesDirection getDirection() const;
+
+    /**
+     * @brief Sets the IV that every following message starts from. The key is not expanded again.
+     * @details Takes effect at the next `reset` or `process`.
+     * @param iv The 16-byte IV or initial counter block.
+     * @throws std::length_error If the IV is not 16 bytes.
+     */
+    void setIv(const String& iv);
+
+    /**
+     * @brief Turns PKCS#7 padding of ECB and CBC on or off. It is on by default.
+     * @details Without padding, messages must be a whole number of blocks, and a decrypting stream writes every
+     *          block as soon as it is complete instead of holding the last one back.
+     * @param enabled Whether to pad.
+     */
+    void setPadding(bool enabled);
+
+    /**
+     * @brief Gets the size of the padded ciphertext of a message.
+     * @param size The plaintext size.
+     * @return The next multiple of the block size above `size`.
+     */
+    static datatype_size getCiphertextSize(datatype_size size);
+
+    /**
+     * @brief Gets the most bytes a call to `update` or `process` can write.
+     * @param size The input size.
+     * @return `size` for CTR or without padding, otherwise `size` plus one block.
+     */
+    datatype_size getOutputBound(datatype_size size) const;
+
+    /**
+     * @brief Starts a new stream from the current IV, discarding any unfinished one.
+     * @throws std::runtime_error If OpenSSL fails.
+     */
+    void reset();
+
+    /**
+     * @brief Processes the next chunk of a stream.
+     * @param input The chunk.
+     * @param output The destination, at least `getOutputBound(input.size())` bytes. May be `input` itself but
+     *               must not overlap it otherwise.
+     * @return The number of bytes written, which for ECB and CBC may differ from the input size by up to a block
+     *         because incomplete blocks are carried over to the next call.
+     * @throws std::invalid_argument If `output` is too small.
+     * @throws std::runtime_error If OpenSSL fails.
+     */
+    datatype_size update(std::span<const uint8> input, std::span<uint8> output);
+
+    /**
+     * @brief Ends a stream, writing the padded last block or checking and removing the padding.
+     * @param output The destination, at least one block for ECB and CBC. Unused for CTR.
+     * @return The number of bytes written.
+     * @throws std::invalid_argument If `output` is too small.
+     * @throws std::runtime_error If OpenSSL fails, or if the padding of a decrypted stream is invalid.
+     */
+    datatype_size finalize(std::span<uint8> output);
+
+    /**
+     * @brief Processes one whole message into a caller-provided buffer: `reset`, `update` and `finalize`.
+     * @param input The message.
+     * @param size The message size.
+     * @param output The destination, at least `getOutputBound(size)` bytes. Must not overlap `input`.
+     * @return The number of bytes written.
+     * @throws std::runtime_error If OpenSSL fails or the padding of a decrypted message is invalid.
+     */
+    datatype_size process(const uint8* input, datatype_size size, uint8* output);
+
+    /**
+     * @brief Processes one whole message.
+     * @param input The message.
+     * @return The ciphertext or plaintext.
+     * @throws std::runtime_error If OpenSSL fails or the padding of a decrypted message is invalid.
+     */
+    String process(const String& input);
+
+    /**
+     * @brief Processes a file into another file at constant memory.
+     * @details The file is read, processed and written in chunks of `buffer_size` bytes through two input and
+     *          two output buffers: while one chunk is being processed, the next is read and the previous one
+     *          written on other threads. Memory use is four buffers, whatever the file size.
+     * @param input_path The file to read.
+     * @param output_path The file to create or overwrite.
+     * @param buffer_size The chunk size. Must be positive.
+     * @return The number of bytes written.
+     * @throws std::invalid_argument If `buffer_size` is 0.
+     * @throws std::runtime_error If a file cannot be opened, read or written, or processing fails.
+     */
+    uint64 processFile(const String& input_path, const String& output_path,
+                       datatype_size buffer_size = default_file_buffer_size);
+
+private:
+    /**
+     * @brief Frees an OpenSSL cipher context.
+     */
+    struct ContextDeleter {
+        void operator()(EVP_CIPHER_CTX* context) const;
+    };
+
+    AesMode mode;
+    AesDirection direction;
+    bool padding = true;
+    std::unique_ptr<EVP_CIPHER_CTX, ContextDeleter> context;
+    Array(uint8, block_size) iv;
+};
+
+#endif //CRYPTOGRAPHY1_AESCONTEXT_H
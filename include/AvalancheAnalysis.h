@@ -0,0 +1,123 @@
+#ifndef CRYPTOGRAPHY1_AVALANCHEANALYSIS_H
+#define CRYPTOGRAPHY1_AVALANCHEANALYSIS_H
+
+#include "Types.h"
+#include <functional>
+
+class ThreadPool;
+
+/**
+ * @struct AvalancheOptions
+ * @brief Size and seeding of an `AvalancheAnalysis` run.
+ */
+struct AvalancheOptions {
+    uint64 trials = 1024;     ///< Random inputs; every input bit is flipped once per input.
+    uint32 batch_size = 64;   ///< Inputs per batch. Batch b draws from a generator seeded with `seed + b`.
+    uint64 seed = 1;          ///< The base seed.
+};
+
+/**
+ * @struct ConfidenceInterval
+ * @brief An estimate with the bounds of its confidence interval.
+ */
+struct ConfidenceInterval {
+    float64 estimate; ///< The point estimate.
+    float64 lower;    ///< The lower bound.
+    float64 upper;    ///< The upper bound.
+};
+
+/**
+ * @struct AvalancheReport
+ * @brief The counters of an avalanche run and the statistics derived from them.
+ * @details A pair is one random input and the same input with one bit flipped. For a cipher with good
+ *          diffusion every output bit flips with probability 1/2 whichever input bit is flipped (the strict
+ *          avalanche criterion), so about half of the output bits differ.
+ */
+struct AvalancheReport {
+    uint32 input_bits = 0;            ///< The number of input bits.
+    uint32 output_bits = 0;           ///< The number of output bits.
+    uint64 trials = 0;                ///< The number of random inputs, and of pairs per input bit.
+    Vector(uint64) flip_counts;       ///< [i * output_bits + j]: pairs differing in input bit i whose outputs differ in bit j.
+    Vector(uint64) distance_counts;   ///< [d]: pairs whose outputs differ in exactly d bits, for d = 0..output_bits.
+
+    /**
+     * @brief Gets the number of input/output pairs compared, `trials * input_bits`.
+     */
+    uint64 getPairs() const;
+
+    /**
+     * @brief Estimates the probability that flipping an input bit flips an output bit, with a Wilson interval.
+     * @param input_bit The input bit, 0 for the least significant bit of the first byte.
+     * @param output_bit The output bit, numbered the same way.
+     * @param z The normal quantile of the confidence level, 1.96 for 95%.
+     */
+    ConfidenceInterval getFlipProbability(uint32 input_bit, uint32 output_bit, float64 z = 1.96) const;
+
+    /**
+     * @brief Estimates the mean fraction of output bits that differ within a pair, with a normal interval.
+     * @param z The normal quantile of the confidence level.
+     */
+    ConfidenceInterval getMeanFlipFraction(float64 z = 1.96) const;
+
+    /**
+     * @brief Gets the largest distance of a flip probability from 1/2, over the whole matrix.
+     */
+    float64 getMaxSacBias() const;
+
+    /**
+     * @brief Counts the matrix entries whose confidence interval excludes 1/2.
+     * @details With z = 1.96 about 5% of the entries of an ideal cipher fall outside by chance.
+     * @param z The normal quantile of the confidence level.
+     */
+    uint64 countSacViolations(float64 z = 1.96) const;
+};
+
+/**
+ * @class AvalancheAnalysis
+ * @brief Measures the diffusion of any fixed-size cipher by flipping every input bit of many random inputs.
+ * @details For every random input x and every input bit i, the harness encrypts x and x with bit i flipped and
+ *          counts, for every output bit j, whether the two outputs differ there. This fills the strict
+ *          avalanche criterion matrix and the distribution of output Hamming distances, from which
+ *          `AvalancheReport` derives flip probabilities and confidence intervals. Each input costs
+ *          `1 + input_bits` cipher calls.
+ *
+ *          Inputs are drawn in batches. Every batch has its own seeded generator, and every worker of the pool
+ *          takes a fixed share of the batches and counts into its own matrix, so workers never contend. The
+ *          matrices are added up at the end. Since the batches and their seeds do not depend on the number of
+ *          threads, neither do the results.
+ */
+class AvalancheAnalysis {
+public:
+    /**
+     * @brief Encrypts one input of `input_size` bytes into `output_size` bytes.
+     */
+    using Cipher = std::function<void(const uint8* input, uint8* output)>;
+
+    /**
+     * @brief Creates a cipher for the exclusive use of one worker, for ciphers with per-call state.
+     */
+    using CipherFactory = std::function<Cipher()>;
+
+    /**
+     * @brief Runs the analysis with one cipher instance per worker.
+     * @param make_cipher Called once per worker, on that worker's thread.
+     * @param input_size The input size in bytes. Must be positive.
+     * @param output_size The output size in bytes. Must be positive.
+     * @param pool The pool to run on.
+     * @param options The number of trials and the seed.
+     * @return The counters.
+     * @throws std::invalid_argument If a size or the batch size is 0.
+     * @throws Whatever the factory or the cipher throws.
+     */
+    static AvalancheReport run(const CipherFactory& make_cipher, datatype_size input_size, datatype_size output_size,
+                               ThreadPool& pool, const AvalancheOptions& options = AvalancheOptions());
+
+    /**
+     * @brief Runs the analysis with a cipher that is safe to call from several threads at once.
+     * @see run(const CipherFactory&, datatype_size, datatype_size, ThreadPool&, const AvalancheOptions&)
+     */
+    static AvalancheReport run(const Cipher& cipher, datatype_size input_size, datatype_size output_size,
+                               ThreadPool& pool, const AvalancheOptions& options = AvalancheOptions());
+};
+
+#endif //CRYPTOGRAPHY1_AVALANCHEANALYSIS_H
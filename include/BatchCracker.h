@@ -0,0 +1,130 @@
+#ifndef CRYPTOGRAPHY1_BATCHCRACKER_H
+#define CRYPTOGRAPHY1_BATCHCRACKER_H
+
+#include "Types.h"
+#include <functional>
+
+class ThreadPool;
+
+/**
+ * @struct CrackJob
+ * @brief One ciphertext to crack.
+ */
+struct CrackJob {
+    uint64 id;         ///< The position of the job in its batch, from 0.
+    String name;       ///< Where the ciphertext came from, such as a file name or line number.
+    String ciphertext; ///< The Vigenère ciphertext.
+};
+
+/**
+ * @struct CrackResult
+ * @brief The outcome of one job.
+ */
+struct CrackResult {
+    uint64 id;         ///< The id of the job.
+    String name;       ///< The name of the job.
+    uint32 key_length; ///< The key length found by the Friedman test.
+    String key;        ///< The key found by frequency analysis.
+    String plaintext;  ///< The ciphertext deciphered with the key.
+    String error;      ///< Empty on success, otherwise why the job failed.
+    float64 seconds;   ///< The time the pipeline took for this job.
+};
+
+/**
+ * @struct BatchStats
+ * @brief Aggregate figures of a batch run.
+ */
+struct BatchStats {
+    uint64 jobs = 0;             ///< The number of jobs run.
+    uint64 failed = 0;           ///< The number of jobs that ended with an error.
+    uint64 bytes = 0;            ///< The total ciphertext size.
+    float64 wall_seconds = 0.0;  ///< The elapsed time of the whole batch.
+    float64 busy_seconds = 0.0;  ///< The sum of the job times.
+    float64 max_job_seconds = 0.0; ///< The slowest job.
+
+    /**
+     * @brief Gets the number of jobs finished per second of wall time.
+     */
+    float64 getJobsPerSecond() const;
+
+    /**
+     * @brief Gets the number of ciphertext bytes processed per second of wall time.
+     */
+    float64 getBytesPerSecond() const;
+};
+
+/**
+ * @class BatchCracker
+ * @brief Cracks many independent Vigenère ciphertexts concurrently.
+ * @details A producer, the calling thread, reads jobs into a bounded queue. Each worker of the pool runs a loop
+ *          that takes a job, runs the Friedman test, frequency analysis and decryption on it, and passes the
+ *          result to the sink. The sink is called by one worker at a time, in order of completion. A full queue
+ *          blocks the producer and a slow sink holds the workers, so memory use stays bounded however large the
+ *          batch is.
+ */
+class BatchCracker {
+public:
+    /**
+     * @brief Supplies the next job. Returns false when there are no more.
+     */
+    using JobSource = std::function<bool(CrackJob&)>;
+
+    /**
+     * @brief Receives every result as it finishes.
+     */
+    using ResultSink = std::function<void(const CrackResult&)>;
+
+    /**
+     * @brief The default number of jobs that may wait in the queue.
+     */
+    static constexpr uint32 default_queue_capacity = 256;
+
+    /**
+     * @brief The default bound on the key length, as in `exercise2`.
+     */
+    static constexpr uint32 default_max_key_length = 20;
+
+    /**
+     * @brief Creates a cracker that runs on a pool.
+     * @param pool The pool whose threads become the workers. It must not be used by others during `run`.
+     * @param queue_capacity The number of jobs that may wait in the queue. Must be positive.
+     * @param max_key_length One past the largest key length the Friedman test considers.
+     * @throws std::invalid_argument If `queue_capacity` is 0.
+     */
+    explicit BatchCracker(ThreadPool& pool, uint32 queue_capacity = default_queue_capacity,
+                          uint32 max_key_length = default_max_key_length);
+
+    /**
+     * @brief Cracks every job a source supplies.
+     * @param source The job source, called from the calling thread only.
+     * @param sink The result sink.
+     * @return The batch statistics.
+     * @throws Whatever the source or the sink throws, after the workers have stopped.
+     */
+    BatchStats run(const JobSource& source, const ResultSink& sink);
+
+    /**
+     * @brief Cracks the ciphertexts of a directory or of a newline-delimited file.
+     * @param path A directory, in which every regular file is one ciphertext, taken in name order, or a file
+     *             in which every non-empty line is one ciphertext.
+     * @param sink The result sink.
+     * @return The batch statistics.
+     * @throws std::runtime_error If the path cannot be read.
+     */
+    BatchStats runPath(const String& path, const ResultSink& sink);
+
+    /**
+     * @brief Runs the pipeline on one job in the calling thread.
+     * @param job The job.
+     * @param max_key_length One past the largest key length the Friedman test considers.
+     * @return The result. Failures are reported in `CrackResult::error`.
+     */
+    static CrackResult crack(const CrackJob& job, uint32 max_key_length);
+
+private:
+    ThreadPool& pool;
+    uint32 queue_capacity;
+    uint32 max_key_length;
+};
+
+#endif //CRYPTOGRAPHY1_BATCHCRACKER_H
@@ -0,0 +1,83 @@
+#ifndef CRYPTOGRAPHY1_BOUNDEDQUEUE_H
+#define CRYPTOGRAPHY1_BOUNDEDQUEUE_H
+
+#include "Types.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * @class BoundedQueue
+ * @brief A blocking multi-producer, multi-consumer FIFO queue with a fixed capacity.
+ * @details `push` blocks while the queue is full, so a producer that outruns its consumers is held back
+ *          instead of buffering without limit. After `close`, pushes are refused and `pop` drains what is
+ *          left, then reports the end.
+ * @tparam T The element type.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief Creates an empty queue.
+     * @param capacity The largest number of queued elements. Must be positive.
+     */
+    explicit BoundedQueue(datatype_size capacity) : capacity(capacity) {
+    }
+
+    /**
+     * @brief Appends an element, waiting for space if the queue is full.
+     * @param value The element.
+     * @return False if the queue was closed, in which case the element is dropped.
+     */
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(value));
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Takes the oldest element, waiting for one if the queue is empty.
+     * @param value Receives the element.
+     * @return False once the queue is closed and empty.
+     */
+    bool pop(T& value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        value = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Refuses further pushes and wakes every waiting thread.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+private:
+    const datatype_size capacity;
+    std::deque<T> items;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+};
+
+#endif //CRYPTOGRAPHY1_BOUNDEDQUEUE_H
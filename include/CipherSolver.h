@@ -0,0 +1,87 @@
+#ifndef CRYPTOGRAPHY1_CIPHERSOLVER_H
+#define CRYPTOGRAPHY1_CIPHERSOLVER_H
+
+#include "Types.h"
+#include "LanguageModel.h"
+
+class ThreadPool;
+
+/**
+ * @struct SolverOptions
+ * @brief Tuning of a `CipherSolver` search.
+ */
+struct SolverOptions {
+    uint32 restarts = 8;              ///< Independent searches, run in parallel. The first starts from frequency analysis.
+    uint32 iterations = 20000;        ///< Proposed key changes per search.
+    float64 initial_temperature = 10.0; ///< Annealing temperature in log10 fitness units; 0 gives hill climbing.
+    float64 final_temperature = 0.05;   ///< The temperature reached on the last iteration.
+    uint64 seed = 1;                  ///< Search r draws from a generator seeded with `seed + r`.
+};
+
+/**
+ * @struct SolverResult
+ * @brief The best key a `CipherSolver` search found.
+ */
+struct SolverResult {
+    Vector(uint8) key; ///< Vigenère: the shift of every column. Substitution: the plaintext letter of every ciphertext letter.
+    float64 fitness;   ///< The n-gram fitness of the plaintext under the key; higher is better.
+};
+
+/**
+ * @class CipherSolver
+ * @brief Refines classical cipher keys by simulated annealing under n-gram fitness.
+ * @details Every search keeps the current plaintext and its fitness under the highest n-gram order of the
+ *          model. A key change rewrites only the plaintext letters it affects and rescores only the n-grams
+ *          that contain one of them, so a step costs in proportion to the letters it touches, not to the
+ *          text. A worse key is accepted with probability 10^(delta / T), and T falls geometrically from the
+ *          initial to the final temperature.
+ *
+ *          The searches of one call run as tasks on a thread pool. Each draws from its own seeded generator
+ *          and the best result is picked in search order, so the outcome does not depend on scheduling.
+ *
+ *          Letter indices follow the model alphabet; index `alphabet_size` marks a non-letter, which is kept
+ *          in place, breaks n-grams and, for Vigenère, still advances the key.
+ */
+class CipherSolver {
+public:
+    /**
+     * @brief Recovers a Vigenère key of known length.
+     * @details The first search starts from the chi-squared key of `FrequencyAnalysis`, the others from random
+     *          keys. A step changes one key letter.
+     * @param indices The letter indices of the ciphertext.
+     * @param size The number of indices.
+     * @param key_length The key length. Must be positive.
+     * @param model The plaintext language.
+     * @param pool The pool to run the searches on.
+     * @param options The search parameters.
+     * @return The best key found.
+     * @throws std::invalid_argument If `key_length` is 0.
+     */
+    static SolverResult solveVigenere(const uint8* indices, datatype_size size, uint32 key_length,
+                                      const LanguageModel& model, ThreadPool& pool,
+                                      const SolverOptions& options = SolverOptions());
+
+    /**
+     * @brief Recovers the key of a monoalphabetic substitution.
+     * @details The first search starts by matching the letters of the ciphertext and of the language in order of
+     *          frequency, the others from random permutations. A step swaps the images of two letters.
+     * @see solveVigenere
+     */
+    static SolverResult solveSubstitution(const uint8* indices, datatype_size size, const LanguageModel& model,
+                                          ThreadPool& pool, const SolverOptions& options = SolverOptions());
+
+    /**
+     * @brief Recovers the key of an English-alphabet Vigenère ciphertext.
+     * @param message The ciphertext.
+     * @param key_length The key length.
+     * @param model The plaintext language, over the 26-letter alphabet.
+     * @param pool The pool to run the searches on.
+     * @param options The search parameters.
+     * @return The lowercase key.
+     * @see solveVigenere
+     */
+    static String solveVigenereKey(const String& message, uint32 key_length, const LanguageModel& model,
+                                   ThreadPool& pool, const SolverOptions& options = SolverOptions());
+};
+
+#endif //CRYPTOGRAPHY1_CIPHERSOLVER_H
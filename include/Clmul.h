@@ -0,0 +1,108 @@
+#ifndef CRYPTOGRAPHY1_CLMUL_H
+#define CRYPTOGRAPHY1_CLMUL_H
+
+#include "Types.h"
+
+/**
+ * @class Clmul
+ * @brief Carry-less (GF(2)[x]) multiplication kernels on packed 64-bit words.
+ *
+ * Operands are arrays of words holding 64 coefficients each, lowest degree first, exactly like the
+ * storage of `GF2Polynomial`. The 64x64 -> 128 bit base case uses the PCLMULQDQ instruction when the
+ * CPU reports it at runtime and a portable bit-sliced integer-multiply fallback otherwise, so the same
+ * binary runs on every x86-64 node as well as on other architectures. Operands of at least
+ * `karatsuba_threshold` words are split recursively with Karatsuba.
+ */
+class Clmul {
+public:
+    /**
+     * @brief The operand size, in words, from which multiplication switches from schoolbook to Karatsuba.
+     */
+    static constexpr datatype_size karatsuba_threshold = 16;
+
+    /**
+     * @brief Multiplies two GF(2) polynomials given as packed words.
+     * @param a The words of the first operand.
+     * @param a_size The number of words in `a`.
+     * @param b The words of the second operand.
+     * @param b_size The number of words in `b`.
+     * @param out The destination, which must hold `a_size + b_size` words and must not alias `a` or `b`.
+     *            It is overwritten.
+     */
+    static void multiply(const uint64* a, datatype_size a_size, const uint64* b, datatype_size b_size, uint64* out);
+
+    /**
+     * @brief Multiplies two GF(2) polynomials given as packed words, without allocating.
+     * @param a The words of the first operand.
+     * @param a_size The number of words in `a`.
+     * @param b The words of the second operand.
+     * @param b_size The number of words in `b`.
+     * @param out The destination, as for the allocating overload.
+     * @param scratch Temporary storage of at least `multiplyScratchSize(a_size, b_size)` words.
+     */
+    static void multiply(const uint64* a, datatype_size a_size, const uint64* b, datatype_size b_size, uint64* out,
+                         uint64* scratch);
+
+    /**
+     * @brief Computes how much scratch memory `multiply` needs for given operand sizes.
+     * @param a_size The number of words in the first operand.
+     * @param b_size The number of words in the second operand.
+     * @return The number of scratch words, 0 when the shorter operand is below `karatsuba_threshold`.
+     */
+    static datatype_size multiplyScratchSize(datatype_size a_size, datatype_size b_size);
+
+    /**
+     * @brief Squares a GF(2) polynomial given as packed words.
+     * @details Squaring over GF(2) is linear, so it only spreads bit i of the input to bit 2i of the output.
+     * @param a The words of the operand.
+     * @param a_size The number of words in `a`.
+     * @param out The destination, which must hold `2 * a_size` words and must not alias `a`. It is overwritten.
+     */
+    static void square(const uint64* a, datatype_size a_size, uint64* out);
+
+    /**
+     * @brief Multiplies two 64-coefficient polynomials into a 128-coefficient product.
+     * @param a The first operand.
+     * @param b The second operand.
+     * @param low Receives the coefficients of x^0 to x^63 of the product.
+     * @param high Receives the coefficients of x^64 to x^127 of the product.
+     */
+    static void multiplyWord(uint64 a, uint64 b, uint64& low, uint64& high);
+
+    /**
+     * @brief Reports whether the hardware carry-less multiply instruction is being used.
+     * @return True if the PCLMULQDQ kernel was selected at runtime, false for the scalar fallback.
+     */
+    static bool hasHardwareSupport();
+
+private:
+    /**
+     * @brief Signature shared by the hardware and scalar schoolbook kernels.
+     */
+    using SchoolbookKernel = void (*)(const uint64*, datatype_size, const uint64*, datatype_size, uint64*);
+
+    /**
+     * @brief Picks the schoolbook kernel for this CPU. Evaluated once.
+     * @return The kernel to use for all base-case multiplications.
+     */
+    static SchoolbookKernel selectKernel();
+
+    /**
+     * @brief Karatsuba multiplication of two operands of the same size.
+     * @param a The first operand, `size` words.
+     * @param b The second operand, `size` words.
+     * @param size The number of words in each operand.
+     * @param out The destination, `2 * size` words.
+     * @param scratch Temporary storage of at least `scratchSize(size)` words.
+     */
+    static void karatsuba(const uint64* a, const uint64* b, datatype_size size, uint64* out, uint64* scratch);
+
+    /**
+     * @brief Computes how much scratch memory `karatsuba` needs for a given operand size.
+     * @param size The number of words in each operand.
+     * @return The number of scratch words.
+     */
+    static datatype_size scratchSize(datatype_size size);
+};
+
+#endif //CRYPTOGRAPHY1_CLMUL_H
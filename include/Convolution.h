@@ -0,0 +1,95 @@
+#ifndef CRYPTOGRAPHY1_CONVOLUTION_H
+#define CRYPTOGRAPHY1_CONVOLUTION_H
+
+#include "Types.h"
+#include "Montgomery.h"
+
+/**
+ * @class Convolution
+ * @brief Multiplication engine for integer polynomial coefficient vectors.
+ *
+ * Coefficient vectors are ordered from the lowest degree to the highest, like the internal storage of
+ * `Polynomial`. The engine picks schoolbook multiplication for short operands, Karatsuba for medium ones
+ * and a number-theoretic transform over three NTT-friendly primes, recombined with the CRT, for long ones.
+ * All three compute the product modulo 2^32, which is exactly the int32 result whenever it does not
+ * overflow and the same wrapped value as the schoolbook loop whenever it does.
+ */
+class Convolution {
+public:
+    /**
+     * @brief The shorter operand size from which Karatsuba replaces schoolbook multiplication.
+     */
+    static constexpr datatype_size karatsuba_threshold = 32;
+
+    /**
+     * @brief The shorter operand size from which the NTT replaces Karatsuba.
+     */
+    static constexpr datatype_size ntt_threshold = 1 << 13;
+
+    /**
+     * @brief Multiplies two coefficient vectors.
+     * @param a The coefficients of the first polynomial, lowest degree first.
+     * @param b The coefficients of the second polynomial, lowest degree first.
+     * @return The `a.size() + b.size() - 1` coefficients of the product, or an empty vector if either input is empty.
+     */
+    static Vector(int32) multiply(const Vector(int32)& a, const Vector(int32)& b);
+
+    /**
+     * @brief Computes the power series inverse of a polynomial by Newton iteration.
+     * @details Each step doubles the precision with g = g * (2 - f * g) mod x^(2k), so the cost is a
+     *          constant number of multiplications at the final precision.
+     * @param f The coefficients of the series, lowest degree first. f[0] must be 1 or -1.
+     * @param precision The number of coefficients of the inverse to compute.
+     * @return The first `precision` coefficients of 1 / f.
+     * @throws std::invalid_argument If f is empty or f[0] is not a unit.
+     */
+    static Vector(int32) inverseSeries(const Vector(int32)& f, datatype_size precision);
+
+private:
+    /**
+     * @brief Schoolbook multiplication modulo 2^32.
+     * @param out The destination, `a_size + b_size` values. It is overwritten.
+     */
+    static void schoolbook(const uint32* a, datatype_size a_size, const uint32* b, datatype_size b_size, uint32* out);
+
+    /**
+     * @brief Karatsuba multiplication modulo 2^32 of two operands of the same size.
+     * @param out The destination, `2 * size` values.
+     * @param scratch Temporary storage of at least `karatsubaScratchSize(size)` values.
+     */
+    static void karatsuba(const uint32* a, const uint32* b, datatype_size size, uint32* out, uint32* scratch);
+
+    /**
+     * @brief Computes how much scratch memory `karatsuba` needs for a given operand size.
+     */
+    static datatype_size karatsubaScratchSize(datatype_size size);
+
+    /**
+     * @brief Multiplies operands of any sizes by cutting the longer one into balanced Karatsuba blocks.
+     */
+    static Vector(uint32) multiplyKaratsuba(const Vector(uint32)& a, const Vector(uint32)& b);
+
+    /**
+     * @brief Multiplies with one NTT per prime and recombines the residues modulo 2^32.
+     */
+    static Vector(uint32) multiplyNtt(const Vector(uint32)& a, const Vector(uint32)& b);
+
+    /**
+     * @brief Runs an in-place number-theoretic transform modulo an NTT-friendly prime.
+     * @details The forward transform leaves its output in bit-reversed order and the inverse transform expects
+     *          that order, so a pointwise product between the two needs no permutation.
+     * @param values The values to transform, in Montgomery form. The size must be a power of two dividing prime - 1.
+     *               The inverse transform returns them in standard form.
+     * @param field Montgomery arithmetic modulo the prime.
+     * @param generator A primitive root modulo the prime.
+     * @param inverse True for the inverse transform, including the division by the size.
+     */
+    static void ntt(Vector(uint32)& values, const Montgomery<uint32>& field, uint32 generator, bool inverse);
+
+    /**
+     * @brief Picks the algorithm by operand size and multiplies modulo 2^32.
+     */
+    static Vector(uint32) multiplyUnsigned(const Vector(uint32)& a, const Vector(uint32)& b);
+};
+
+#endif //CRYPTOGRAPHY1_CONVOLUTION_H
@@ -3,17 +3,6 @@
 
 #include "Types.h"
 
-/**
- * @struct WordOccurrences
- * @brief Represents a recurring word found in a ciphertext.
- * @details This struct is used to store a word and the number of times it appears in a text,
- *          which is particularly useful in frequency analysis and the Kasiski examination.
- */
-struct WordOccurrences {
-    uint32 count; ///< The number of times the word occurs.
-    String word;  ///< The recurring word itself.
-};
-
 /**
  * @class Crypto
  * @brief Provides a suite of static methods for cryptographic analysis and operations.
@@ -25,9 +14,11 @@ class Crypto {
 public:
     /**
      * @brief Estimates the most probable key length of a polyalphabetic cipher using the Kasiski examination.
-     * @details This method identifies repeated sequences of characters in the ciphertext and calculates the
-     *          distances between them. The greatest common divisor (GCD) of these distances is likely
-     *          to be the key length.
+     * @details This method identifies every repeated sequence of characters in the ciphertext and collects the
+     *          factors of the distances between their occurrences. The largest factor shared by nearly as many
+     *          distances as the most common one is likely to be the key length. See `Kasiski`. Factors up to
+     *          half the message length, and at least up to `Kasiski::default_max_factor`, are considered, so
+     *          the estimate is never above that limit.
      * @param message The ciphertext to analyze.
      * @param min_word_length The minimum length of a recurring word to be considered for the analysis.
      * @return The estimated key length. Returns 0 if no recurring words are found.
@@ -48,12 +39,13 @@ public:
 
     /**
      * @brief Derives a potential key for a Vigenère cipher through frequency analysis.
-     * @details This function assumes the underlying plaintext is English and that the most frequent character
-     *          in each column of the ciphertext (when arranged by key length) corresponds to 'E'.
-     *          By calculating the shift for each column, a probable key is derived.
+     * @details This function assumes the underlying plaintext is English. Every column of the ciphertext
+     *          (when arranged by key length) is deciphered with all 26 shifts, and the shift whose letter
+     *          distribution is closest to English by the chi-squared statistic gives the key letter.
+     * @see FrequencyAnalysis
      * @param message The ciphertext to analyze.
      * @param key_length The length of the key to derive.
-     * @return The derived key as a string.
+     * @return The derived key in lowercase, with '?' for columns that contain no letters.
      */
     static String getKeyWithFrequencyAnalysis(const String &message, uint32 key_length);
 
@@ -64,9 +56,22 @@ public:
      * @param message The ciphertext to decrypt.
      * @param key The key to use for decryption.
      * @return The decrypted message (plaintext).
+     * @throws std::invalid_argument If the key is empty.
+     * @see Vigenere
      */
     static String vigenereDecipher(const String &message, String key);
 
+    /**
+     * @brief Encrypts a message with the Vigenère cipher.
+     * @details The inverse of `vigenereDecipher`: every letter is shifted forward by the key letter at its
+     *          position and written in lowercase, and every other character is copied.
+     * @param message The plaintext to encrypt.
+     * @param key The key to use for encryption.
+     * @return The encrypted message (ciphertext).
+     * @throws std::invalid_argument If the key is empty.
+     */
+    static String vigenereEncipher(const String &message, const String& key);
+
     /**
      * @brief Decrypts a 16-bit message that was encrypted with a specific linear transformation.
      * @details The decryption formula is the inverse of the encryption function. By analyzing the
@@ -129,82 +134,47 @@ public:
 
     /**
      * @brief Encrypts a plaintext using AES in ECB mode.
+     * @details Expands the key for this one message; reuse an `AesContext` to encrypt many with one key.
      * @param key The encryption key.
      * @param plaintext The plaintext to encrypt.
      * @return The encrypted ciphertext.
+     * @throws std::length_error If the key is not 16 bytes.
+     * @throws std::runtime_error If OpenSSL fails.
      */
     static String encryptECB(const String& key, const String& plaintext);
 
+    /**
+     * @brief Decrypts a ciphertext produced by `encryptECB`.
+     * @param key The encryption key.
+     * @param ciphertext The ciphertext, a whole number of blocks.
+     * @return The plaintext with the padding removed.
+     * @throws std::length_error If the key is not 16 bytes.
+     * @throws std::runtime_error If OpenSSL fails or the padding is invalid.
+     */
+    static String decryptECB(const String& key, const String& ciphertext);
+
     /**
      * @brief Encrypts a plaintext using AES in CBC mode.
+     * @details Expands the key for this one message; reuse an `AesContext` to encrypt many with one key.
      * @param key The encryption key.
      * @param iv The initialization vector.
      * @param plaintext The plaintext to encrypt.
      * @return The encrypted ciphertext.
+     * @throws std::length_error If the key or the IV is not 16 bytes.
+     * @throws std::runtime_error If OpenSSL fails.
      */
     static String encryptCBC(const String& key, const String& iv, const String& plaintext);
 
-private:
-    /**
-     * @brief Finds the most frequent alphabetic character in a string.
-     * @details This function is case-insensitive and is typically used in frequency analysis to guess
-     *          which character corresponds to the most common letter in a language (e.g., 'E' in English).
-     * @param text The string to analyze.
-     * @return The most frequent character. Returns a space (' ') if no alphabetic characters are found.
-     */
-    static char findMostFrequentCharInString(const String& text);
-
     /**
-     * @brief Transposes a ciphertext matrix to align characters by key position.
-     * @details This method organizes the ciphertext into columns based on the key length and then
-     *          reconstructs them into rows. This is not a standard cryptographic operation but can
-     *          be useful for specific analytical approaches.
-     * @param message The ciphertext to process.
-     * @param keyLength The assumed length of the encryption key.
-     * @return A vector of strings, where each string is a reconstructed row.
-     */
-    static Vector(String) splitEncryptedMessageReturnRows(const String &message, uint32 keyLength);
-
-    /**
-     * @brief Splits a ciphertext into columns based on the key length.
-     * @details This is a crucial step for frequency analysis of polyalphabetic ciphers. Each column
-     *          contains characters that were encrypted with the same key character, forming a simple
-     *          monoalphabetic substitution cipher that can be broken individually.
-     * @param message The ciphertext to split.
-     * @param keyLength The assumed length of the encryption key.
-     * @return A vector of strings, where each string represents a column of the ciphertext.
-     */
-    static Vector(String) splitEncryptedMessageReturnColumns(const String &message, uint32 keyLength);
-
-    /**
-     * @brief Finds all recurring words of a specified minimum length in a text.
-     * @details This is the core of the Kasiski examination. The distances between these recurring
-     *          words can reveal the key length of a polyalphabetic cipher.
-     * @param message The text to search within.
-     * @param minLength The minimum length of words to search for.
-     * @return A vector of `WordOccurrences` structs, detailing each recurring word and its count.
-     */
-    static Vector(WordOccurrences) findRecurringWords(const String &message, uint32 minLength);
-
-    /**
-     * @brief Calculates the distances between all occurrences of a specific word.
-     * @details Used in the Kasiski examination, the GCD of these distances provides a strong
-     *          indicator of the key length.
-     * @param message The text to search within.
-     * @param word The word for which to find occurrence distances.
-     * @return A vector of distances between successive occurrences of the word.
-     */
-    static Vector(uint32) findDistances(const String &message, const String& word);
-
-    /**
-     * @brief Calculates the Index of Coincidence (IC) for a given text.
-     * @details The IC measures the probability that two randomly selected letters from a text are identical.
-     *          It is a powerful tool for distinguishing monoalphabetic from polyalphabetic ciphers and is
-     *          the foundation of the Friedman test for finding the key length.
-     * @param text The text for which to calculate the IC.
-     * @return The calculated Index of Coincidence as a float.
+     * @brief Decrypts a ciphertext produced by `encryptCBC`.
+     * @param key The encryption key.
+     * @param iv The initialization vector used for encryption.
+     * @param ciphertext The ciphertext, a whole number of blocks.
+     * @return The plaintext with the padding removed.
+     * @throws std::length_error If the key or the IV is not 16 bytes.
+     * @throws std::runtime_error If OpenSSL fails or the padding is invalid.
      */
-    static float32 calculateIC(const String& text);
+    static String decryptCBC(const String& key, const String& iv, const String& ciphertext);
 
 };
 
@@ -0,0 +1,127 @@
+#ifndef CRYPTOGRAPHY1_FREQUENCYANALYSIS_H
+#define CRYPTOGRAPHY1_FREQUENCYANALYSIS_H
+
+#include "Types.h"
+#include "LanguageModel.h"
+#include "StridedView.h"
+
+/**
+ * @struct ShiftScore
+ * @brief One Caesar shift of a ciphertext column and how well it fits the language.
+ */
+struct ShiftScore {
+    uint8 shift;        ///< The key letter, 0 for the first letter of the alphabet.
+    float64 chi_squared; ///< The chi-squared statistic of the deciphered column; lower is better.
+};
+
+/**
+ * @class FrequencyAnalysis
+ * @brief Recovers a Vigenère key by chi-squared scoring of every shift of every column.
+ * @details Deciphering a column with shift s maps ciphertext letter i to plaintext letter (i - s) mod n, so
+ *          with observed counts O, N letters and language frequencies p:
+ *
+ *              chi2(s) = sum_i (O_i - N p_(i-s))^2 / (N p_(i-s)) = (1/N) sum_i O_i^2 / p_(i-s) - N.
+ *
+ *          The weights 1 / p are stored once in all n rotations, so the score of a shift is a dot product of
+ *          the squared counts with one table row, with no modulo and no per-letter branches.
+ *
+ *          The scores of a whole ciphertext are kept as a `key_length x n` table. A candidate key is then
+ *          scored by one lookup per key letter, which is cheap enough to sit inside a key search.
+ */
+class FrequencyAnalysis {
+public:
+    /**
+     * @brief Prepares the rotation table for a language.
+     * @param model The language, which must hold letter frequencies.
+     * @throws std::logic_error If the model has no unigram table.
+     */
+    explicit FrequencyAnalysis(const LanguageModel& model = LanguageModel::english());
+
+    /**
+     * @brief Gets the number of letters and therefore of shifts.
+     */
+    uint32 getAlphabetSize() const;
+
+    /**
+     * @brief Scores every shift of one column.
+     * @param counts The number of occurrences of each ciphertext letter.
+     * @param chi_squared Receives the chi-squared statistic of each shift, or 0s if there are no letters.
+     */
+    void scoreShifts(const uint32* counts, float64* chi_squared) const;
+
+    /**
+     * @brief Scores every shift of one column of an English-alphabet ciphertext, read in place.
+     * @param column The column, for example every key-length-th character of the ciphertext.
+     * @param chi_squared Receives the chi-squared statistic of each shift, or 0s if there are no letters.
+     * @throws std::logic_error If the language does not use the 26-letter alphabet.
+     */
+    void scoreShifts(const StridedView& column, float64* chi_squared) const;
+
+    /**
+     * @brief Recovers the most likely shift of one column of an English-alphabet ciphertext.
+     * @param column The column.
+     * @return The key letter, or the alphabet size if the column contains no letters.
+     * @throws std::logic_error If the language does not use the 26-letter alphabet.
+     */
+    uint8 recoverShift(const StridedView& column) const;
+
+    /**
+     * @brief Scores every shift of every column of a ciphertext.
+     * @param indices The letter indices of the ciphertext. Non-letters are skipped but still advance the key.
+     * @param size The number of indices.
+     * @param key_length The key length.
+     * @return result[c * n + s] is the chi-squared statistic of shift s for column c.
+     */
+    Vector(float64) scoreColumns(const uint8* indices, datatype_size size, uint32 key_length) const;
+
+    /**
+     * @brief Scores every shift of every column of an English-alphabet ciphertext.
+     * @see scoreColumns(const uint8*, datatype_size, uint32) const
+     */
+    Vector(float64) scoreColumns(const String& message, uint32 key_length) const;
+
+    /**
+     * @brief Finds the best shifts of every column.
+     * @param column_scores The table returned by `scoreColumns`.
+     * @param k The number of shifts to keep per column, at most the alphabet size.
+     * @return result[c] holds the k best shifts of column c, best first; ties are ordered by shift.
+     */
+    Vector(Vector(ShiftScore)) topShifts(const Vector(float64)& column_scores, uint32 k) const;
+
+    /**
+     * @brief Scores a whole candidate key.
+     * @param column_scores The table returned by `scoreColumns`.
+     * @param shifts The key letters, one per column.
+     * @return The sum of the chi-squared statistics of the columns; lower is better.
+     */
+    float64 scoreKey(const Vector(float64)& column_scores, const uint8* shifts) const;
+
+    /**
+     * @brief Recovers the most likely shift of every column.
+     * @param indices The letter indices of the ciphertext.
+     * @param size The number of indices.
+     * @param key_length The key length.
+     * @return The key letters, with the alphabet size for columns that contain no letters.
+     */
+    Vector(uint8) recoverShifts(const uint8* indices, datatype_size size, uint32 key_length) const;
+
+    /**
+     * @brief Recovers the most likely key of an English-alphabet ciphertext.
+     * @param message The ciphertext.
+     * @param key_length The key length.
+     * @return The lowercase key, with '?' for columns that contain no letters.
+     * @throws std::logic_error If the language does not use the 26-letter alphabet.
+     */
+    String recoverKey(const String& message, uint32 key_length) const;
+
+private:
+    /**
+     * @brief Throws std::logic_error unless the language uses the 26-letter alphabet.
+     */
+    void checkEnglishAlphabet() const;
+
+    uint32 alphabet_size;
+    Vector(float64) rotated_weights; ///< rotated_weights[s * n + i] = 1 / p_((i - s) mod n).
+};
+
+#endif //CRYPTOGRAPHY1_FREQUENCYANALYSIS_H
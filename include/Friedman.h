@@ -0,0 +1,150 @@
+#ifndef CRYPTOGRAPHY1_FRIEDMAN_H
+#define CRYPTOGRAPHY1_FRIEDMAN_H
+
+#include "Types.h"
+
+class LanguageModel;
+class ThreadPool;
+
+/**
+ * @struct KeyLengthCandidate
+ * @brief A key length scored by the Friedman test.
+ */
+struct KeyLengthCandidate {
+    uint32 key_length;  ///< The candidate key length.
+    float64 average_ic; ///< The average Index of Coincidence of its columns.
+    float64 score;      ///< The distance from the expected Index of Coincidence; lower is better.
+};
+
+/**
+ * @class Friedman
+ * @brief Friedman test (Index of Coincidence) over letter indices, for any alphabet size.
+ * @details The text is converted to letter indices once. Each candidate key length L counts letters into a
+ *          flat table of L rows of `alphabet_size + 1` bins, one row per residue of the position modulo L.
+ *          The extra bin absorbs non-letters, so counting has no branches and builds no column strings.
+ *          All candidate lengths are counted in one pass over the indices. Columns are taken by raw
+ *          position, so a non-letter still advances the key, as it does when enciphering with `Vigenere`.
+ */
+class Friedman {
+public:
+    /**
+     * @brief The Index of Coincidence of English plaintext.
+     */
+    static constexpr float64 english_ic = 0.067;
+
+    /**
+     * @brief Computes the Index of Coincidence from letter counts.
+     * @param counts The number of occurrences of each letter.
+     * @param alphabet_size The number of letters.
+     * @return sum(f * (f - 1)) / (N * (N - 1)) over the letters, or 0 if there are fewer than two letters.
+     */
+    static float64 indexOfCoincidence(const uint32* counts, uint32 alphabet_size);
+
+    /**
+     * @brief Computes the average Index of Coincidence of the columns for a range of key lengths.
+     * @details The tables of all lengths lie back to back in one array, and the text is read once: every
+     *          block of it is counted for all lengths while it is still in cache.
+     * @param indices The letter index of every character. Values equal to `alphabet_size` are not letters.
+     * @param size The number of characters.
+     * @param alphabet_size The number of letters.
+     * @param min_key_length The first key length to evaluate. Must be positive.
+     * @param max_key_length One past the last key length to evaluate.
+     * @return result[i] is the average column IC for key length `min_key_length + i`.
+     * @throws std::invalid_argument If `min_key_length` is 0.
+     */
+    static Vector(float64) averageIC(const uint8* indices, datatype_size size, uint32 alphabet_size,
+                                     uint32 min_key_length, uint32 max_key_length);
+
+    /**
+     * @brief Computes the average Index of Coincidence of the columns for one key length.
+     * @param counts Scratch space of at least `key_length * (alphabet_size + 1)` entries.
+     * @see averageIC
+     */
+    static float64 averageIC(const uint8* indices, datatype_size size, uint32 alphabet_size, uint32 key_length,
+                             uint32* counts);
+
+    /**
+     * @brief Adds the letters of a stretch of text to per-residue counters.
+     * @param indices The letter indices of the stretch.
+     * @param size The length of the stretch.
+     * @param alphabet_size The number of letters.
+     * @param key_length The key length.
+     * @param first_residue The residue of the first character of the stretch.
+     * @param counts The counters, `key_length * (alphabet_size + 1)` entries. They are not cleared.
+     */
+    static void countColumns(const uint8* indices, datatype_size size, uint32 alphabet_size, uint32 key_length,
+                             uint32 first_residue, uint32* counts);
+
+    /**
+     * @brief The smallest stretch of text counted by one task when the text is split across workers.
+     */
+    static constexpr datatype_size min_chunk_size = 1 << 16;
+
+    /**
+     * @brief Scores a range of key lengths in parallel and ranks them.
+     * @details The work is split by key length and, when there are fewer key lengths than the pool can keep
+     *          busy, also by text chunk. Every task counts into its own table, and chunk tables are summed
+     *          in chunk order after all tasks finish, so the result does not depend on scheduling.
+     * @param indices The letter index of every character. Values equal to `alphabet_size` are not letters.
+     * @param size The number of characters.
+     * @param alphabet_size The number of letters.
+     * @param min_key_length The first key length to evaluate. Must be positive.
+     * @param max_key_length One past the last key length to evaluate.
+     * @param expected_ic The Index of Coincidence of the plaintext language.
+     * @param pool The pool to run on. Must not be called from one of its tasks.
+     * @return One candidate per key length, best first; equal scores are ordered by key length.
+     * @throws std::invalid_argument If `min_key_length` is 0.
+     */
+    static Vector(KeyLengthCandidate) rankKeyLengths(const uint8* indices, datatype_size size, uint32 alphabet_size,
+                                                     uint32 min_key_length, uint32 max_key_length,
+                                                     float64 expected_ic, ThreadPool& pool);
+
+    /**
+     * @brief Scores the key lengths from 2 up to `max_key_length` of an English ciphertext in parallel.
+     * @param message The ciphertext.
+     * @param max_key_length One past the largest key length to test.
+     * @param pool The pool to run on.
+     * @param expected_ic The Index of Coincidence of the plaintext language.
+     * @return One candidate per key length, best first.
+     * @see rankKeyLengths
+     */
+    static Vector(KeyLengthCandidate) rankKeyLengths(const String& message, uint32 max_key_length, ThreadPool& pool,
+                                                     float64 expected_ic = english_ic);
+
+    /**
+     * @brief Scores a range of key lengths in parallel against a language model.
+     * @details Uses the alphabet size and Index of Coincidence of the model.
+     * @see rankKeyLengths
+     */
+    static Vector(KeyLengthCandidate) rankKeyLengths(const uint8* indices, datatype_size size,
+                                                     uint32 min_key_length, uint32 max_key_length,
+                                                     const LanguageModel& model, ThreadPool& pool);
+
+    /**
+     * @brief Finds the key length whose average column IC is closest to that of the plaintext language.
+     * @param message The English ciphertext.
+     * @param max_key_length One past the largest key length to test; lengths start at 2.
+     * @param expected_ic The Index of Coincidence of the plaintext language.
+     * @return The best key length, or 1 if no length was tested.
+     */
+    static uint32 findKeyLength(const String& message, uint32 max_key_length, float64 expected_ic = english_ic);
+
+    /**
+     * @brief Finds the key length whose average column IC is closest to that of a language model.
+     * @param indices The letter indices of the ciphertext, in the alphabet of the model.
+     * @param size The number of indices.
+     * @param max_key_length One past the largest key length to test; lengths start at 2.
+     * @param model The plaintext language.
+     * @return The best key length, or 1 if no length was tested.
+     */
+    static uint32 findKeyLength(const uint8* indices, datatype_size size, uint32 max_key_length,
+                                const LanguageModel& model);
+
+private:
+    /**
+     * @brief Averages the Index of Coincidence over the columns of a counter table.
+     */
+    static float64 averageColumns(const uint32* counts, uint32 alphabet_size, uint32 key_length);
+};
+
+#endif //CRYPTOGRAPHY1_FRIEDMAN_H
@@ -0,0 +1,143 @@
+#ifndef CRYPTOGRAPHY1_GF2MODULUS_H
+#define CRYPTOGRAPHY1_GF2MODULUS_H
+
+#include "Types.h"
+#include "GF2Polynomial.h"
+
+/**
+ * @class GF2Modulus
+ * @brief Precomputed reduction context for arithmetic modulo a fixed polynomial over GF(2).
+ *
+ * A residue modulo a polynomial f of degree m is stored as `getWordCount()` packed words, exactly like
+ * the words of a `GF2Polynomial` but with a fixed length. The constructor picks a reduction strategy once:
+ * - a sparse path for trinomials and pentanomials whose middle terms lie in the lower half, which folds
+ *   the high part back with a couple of shifts and XORs per term;
+ * - Barrett reduction otherwise, using the precomputed mu = floor(x^(2m) / f) so that a reduction costs two
+ *   carry-less multiplications and no division loop.
+ *
+ * The raw-buffer methods work in scratch memory allocated by the constructor, including the Karatsuba
+ * scratch of `Clmul::multiply` for large moduli, and never allocate, so modular multiplication and
+ * exponentiation can run in a tight loop. Because of that scratch memory a context must not be shared
+ * between threads; create one per thread instead.
+ */
+class GF2Modulus {
+public:
+    /**
+     * @brief Precomputes the reduction data for a modulus.
+     * @param modulus The modulus polynomial.
+     * @throws std::invalid_argument If the modulus has degree 0.
+     */
+    explicit GF2Modulus(const GF2Polynomial& modulus);
+
+    /**
+     * @brief Gets the modulus polynomial.
+     * @return A const reference to the modulus.
+     */
+    const GF2Polynomial& getModulus() const;
+
+    /**
+     * @brief Gets the degree m of the modulus.
+     * @return The degree of the modulus.
+     */
+    uint32 getDegree() const;
+
+    /**
+     * @brief Gets the number of words in a residue.
+     * @return ceil(m / 64).
+     */
+    datatype_size getWordCount() const;
+
+    /**
+     * @brief Reports whether the sparse trinomial/pentanomial reduction path is in use.
+     * @return True for the sparse path, false for Barrett reduction.
+     */
+    bool isSparse() const;
+
+    /**
+     * @brief Converts a polynomial to a residue.
+     * @param value The polynomial to reduce.
+     * @param out The destination, `getWordCount()` words.
+     */
+    void toResidue(const GF2Polynomial& value, uint64* out) const;
+
+    /**
+     * @brief Converts a residue back to a polynomial.
+     * @param residue The residue, `getWordCount()` words.
+     * @return The equivalent polynomial of degree below m.
+     */
+    GF2Polynomial fromResidue(const uint64* residue) const;
+
+    /**
+     * @brief Computes out = a * b mod f without allocating.
+     * @param a The first residue.
+     * @param b The second residue.
+     * @param out The destination residue. May alias `a` or `b`.
+     */
+    void multiply(const uint64* a, const uint64* b, uint64* out);
+
+    /**
+     * @brief Computes out = a^2 mod f without allocating.
+     * @param a The residue to square.
+     * @param out The destination residue. May alias `a`.
+     */
+    void square(const uint64* a, uint64* out);
+
+    /**
+     * @brief Computes out = base^exp mod f without allocating.
+     * @param base The base residue.
+     * @param exp The exponent as 64-bit words, least significant word first.
+     * @param exp_size The number of words in `exp`.
+     * @param out The destination residue. Must not alias `base`.
+     */
+    void power(const uint64* base, const uint64* exp, datatype_size exp_size, uint64* out);
+
+    /**
+     * @brief Computes a * b mod f.
+     * @param a The first polynomial.
+     * @param b The second polynomial.
+     * @return The reduced product.
+     */
+    GF2Polynomial multiply(const GF2Polynomial& a, const GF2Polynomial& b);
+
+    /**
+     * @brief Computes base^exp mod f.
+     * @param base The base polynomial.
+     * @param exp The exponent as 64-bit words, least significant word first.
+     * @return The reduced power.
+     */
+    GF2Polynomial power(const GF2Polynomial& base, const Vector(uint64)& exp);
+
+private:
+    /**
+     * @brief Reduces a double-length product into a residue.
+     * @param product The product, `2 * getWordCount()` words of degree below 2m. Used as scratch.
+     * @param out The destination residue.
+     */
+    void reduce(uint64* product, uint64* out);
+
+    /**
+     * @brief Sparse reduction: folds the bits at and above x^m back onto the low terms of f.
+     */
+    void reduceSparse(uint64* product, uint64* out);
+
+    /**
+     * @brief Barrett reduction using the precomputed mu.
+     */
+    void reduceBarrett(uint64* product, uint64* out);
+
+    GF2Polynomial modulus;
+    uint32 degree;
+    datatype_size word_count;
+
+    bool sparse;
+    Vector(uint32) low_terms;     ///< Exponents of the non-zero terms of f below x^m, for the sparse path.
+    Vector(uint64) mu;            ///< floor(x^(2m) / f), for the Barrett path.
+
+    Vector(uint64) product;       ///< Scratch for a double-length product.
+    Vector(uint64) high;          ///< Scratch for the part of a product at and above x^m.
+    Vector(uint64) wide;          ///< Scratch for the Barrett intermediate products.
+    Vector(uint64) accumulator;   ///< Scratch for exponentiation.
+    Vector(uint64) clmul_scratch; ///< Scratch for `Clmul::multiply` on operands of the modulus size.
+};
+
+#endif //CRYPTOGRAPHY1_GF2MODULUS_H
@@ -0,0 +1,260 @@
+#ifndef CRYPTOGRAPHY1_GF2POLYNOMIAL_H
+#define CRYPTOGRAPHY1_GF2POLYNOMIAL_H
+
+#include "Types.h"
+#include "Polynomial.h"
+
+/**
+ * @brief Represents a polynomial over GF(2) with bit-packed coefficients.
+ *
+ * The coefficients are stored 64 per word, where bit j of words[i] is the coefficient of x^(64*i + j).
+ * Addition is a word-wise XOR and reduction is done by shifting the modulus under the leading term
+ * and XORing it in place, so none of the GF(2) arithmetic has to touch a Vector(int32).
+ * The zero polynomial has no words and, like `Polynomial`, reports a degree of 0.
+ */
+class GF2Polynomial {
+
+public:
+    /**
+     * @brief Constructs the zero polynomial.
+     */
+    GF2Polynomial() = default;
+
+    /**
+     * @brief Constructs a polynomial from a packed bit mask.
+     * @param bits Bit i of the mask is the coefficient of x^i.
+     */
+    explicit GF2Polynomial(uint64 bits);
+
+    /**
+     * @brief Constructs a polynomial from an integer polynomial by reducing its coefficients modulo 2.
+     * @param polynomial The polynomial to convert.
+     */
+    explicit GF2Polynomial(const Polynomial& polynomial);
+
+    /**
+     * @brief Creates a polynomial from packed words.
+     * @param words The packed coefficients, lowest degree first. High zero words are dropped.
+     * @return The polynomial.
+     */
+    static GF2Polynomial fromWords(Vector(uint64) words);
+
+    /**
+     * @brief Creates the monomial x^exponent.
+     * @param exponent The exponent of the monomial.
+     * @return The polynomial x^exponent.
+     */
+    static GF2Polynomial monomial(uint32 exponent);
+
+    /**
+     * @brief Converts the polynomial back to an integer polynomial with 0/1 coefficients.
+     * @return The equivalent `Polynomial`.
+     */
+    Polynomial toPolynomial() const;
+
+    /**
+     * @brief Gets the degree of the polynomial.
+     * @return The degree of the polynomial, or 0 for the zero polynomial.
+     */
+    uint32 getDegree() const;
+
+    /**
+     * @brief Gets the number of non-zero coefficients.
+     * @return The Hamming weight of the coefficient vector.
+     */
+    uint32 getWeight() const;
+
+    /**
+     * @brief Gets a single coefficient.
+     * @param exponent The exponent of the term.
+     * @return True if the coefficient of x^exponent is 1.
+     */
+    bool getCoefficient(uint32 exponent) const;
+
+    /**
+     * @brief Sets a single coefficient.
+     * @param exponent The exponent of the term.
+     * @param value The new value of the coefficient.
+     */
+    void setCoefficient(uint32 exponent, bool value);
+
+    /**
+     * @brief Gets the packed coefficient words, lowest degree first.
+     * @return A const reference to the vector of words.
+     */
+    const Vector(uint64)& getWords() const;
+
+    /**
+     * @brief Checks if the polynomial is zero.
+     * @return True if the polynomial is zero, false otherwise.
+     */
+    bool isZero() const;
+
+    /**
+     * @brief Checks if the polynomial is the constant 1.
+     * @return True if the polynomial is 1, false otherwise.
+     */
+    bool isOne() const;
+
+    /**
+     * @brief Converts the polynomial to a string representation.
+     * @return A string representation of the polynomial.
+     */
+    String toString() const;
+
+    /**
+     * @brief Adds a polynomial in place (word-wise XOR).
+     * @param other The polynomial to add.
+     * @return A reference to this polynomial.
+     */
+    GF2Polynomial& operator+=(const GF2Polynomial& other);
+
+    /**
+     * @brief Overloads the addition operator for polynomials over GF(2).
+     * @param other The polynomial to add.
+     * @return A new polynomial representing the sum.
+     */
+    GF2Polynomial operator+(const GF2Polynomial& other) const;
+
+    /**
+     * @brief Overloads the multiplication operator for polynomials over GF(2).
+     * @details Runs on the `Clmul` kernels: hardware carry-less multiply when available, Karatsuba for large operands.
+     * @param other The polynomial to multiply by.
+     * @return A new polynomial representing the product.
+     */
+    GF2Polynomial operator*(const GF2Polynomial& other) const;
+
+    /**
+     * @brief Squares the polynomial.
+     * @details Squaring over GF(2) only spreads the coefficients apart, so this is much cheaper than `*this * *this`.
+     * @return A new polynomial representing the square.
+     */
+    GF2Polynomial square() const;
+
+    /**
+     * @brief Multiplies by a polynomial in place.
+     * @param other The polynomial to multiply by.
+     * @return A reference to this polynomial.
+     */
+    GF2Polynomial& operator*=(const GF2Polynomial& other);
+
+    /**
+     * @brief Reduces the polynomial in place by shift-and-XOR long division.
+     * @param other The divisor polynomial.
+     * @return A reference to this polynomial, now holding the remainder.
+     * @throws std::invalid_argument If the divisor is zero.
+     */
+    GF2Polynomial& operator%=(const GF2Polynomial& other);
+
+    /**
+     * @brief Overloads the modulo operator for polynomials over GF(2) (returns remainder).
+     * @param other The divisor polynomial.
+     * @return A new polynomial representing the remainder.
+     * @throws std::invalid_argument If the divisor is zero.
+     */
+    GF2Polynomial operator%(const GF2Polynomial& other) const;
+
+    /**
+     * @brief Performs shift-and-XOR long division.
+     * @param dividend The dividend.
+     * @param divisor The divisor. May be the same object as `dividend`.
+     * @param quotient Receives the quotient if not null.
+     * @param remainder Receives the remainder if not null. May alias `dividend`.
+     * @throws std::invalid_argument If the divisor is zero.
+     */
+    static void divide(const GF2Polynomial& dividend, const GF2Polynomial& divisor,
+                       GF2Polynomial* quotient, GF2Polynomial* remainder);
+
+    /**
+     * @brief Multiplies the polynomial by x^shift.
+     * @param shift The number of positions to shift.
+     * @return A new polynomial representing the shifted value.
+     */
+    GF2Polynomial operator<<(uint32 shift) const;
+
+    bool operator==(const GF2Polynomial& other) const;
+    bool operator!=(const GF2Polynomial& other) const;
+
+    /**
+     * @brief Performs modular exponentiation over GF(2).
+     * @details Builds a `GF2Modulus` for `mod`; callers exponentiating repeatedly against the same
+     *          modulus should keep their own context instead.
+     * @param base The base polynomial.
+     * @param exp The exponent.
+     * @param mod The modulus polynomial.
+     * @return The result of (base^exp) mod mod.
+     */
+    static GF2Polynomial powerMod(const GF2Polynomial& base, uint64 exp, const GF2Polynomial& mod);
+
+    /**
+     * @brief Performs modular exponentiation over GF(2) with an exponent wider than 64 bits.
+     * @param base The base polynomial.
+     * @param exp The exponent as 64-bit words, least significant word first.
+     * @param mod The modulus polynomial.
+     * @return The result of (base^exp) mod mod.
+     */
+    static GF2Polynomial powerMod(const GF2Polynomial& base, const Vector(uint64)& exp, const GF2Polynomial& mod);
+
+    /**
+     * @brief Computes the greatest common divisor of two polynomials over GF(2).
+     * @param a The first polynomial.
+     * @param b The second polynomial.
+     * @return The greatest common divisor. Returns zero only if both inputs are zero.
+     */
+    static GF2Polynomial gcd(GF2Polynomial a, GF2Polynomial b);
+
+    /**
+     * @brief Checks if the polynomial is irreducible over GF(2) using Rabin's test.
+     * @details A polynomial f of degree n is irreducible if and only if x^(2^n) = x mod f and
+     *          gcd(x^(2^(n/q)) - x, f) = 1 for every prime factor q of n. The powers x^(2^i) are
+     *          produced by repeated squaring modulo f, so the cost is n modular squarings plus one
+     *          gcd per distinct prime factor of n, for any degree.
+     * @return True if the polynomial is irreducible, false otherwise.
+     */
+    bool isIrreducible() const;
+
+    /**
+     * @brief Checks if the polynomial is primitive over GF(2).
+     * @details An irreducible f of degree m is primitive if x has order exactly n = 2^m - 1 modulo f,
+     *          that is if x^(n/q) != 1 mod f for every prime factor q of n. The prime factors of 2^m - 1
+     *          are computed once per degree and cached, so testing further candidates of the same degree
+     *          only costs the exponentiations. Degrees above 64 are supported when 2^m - 1 is a Mersenne prime.
+     * @return True if the polynomial is primitive, false otherwise.
+     * @throws std::domain_error If the degree is above 64 and 2^m - 1 is not a known Mersenne prime.
+     */
+    bool isPrimitive() const;
+
+private:
+    /**
+     * @brief Gets the distinct prime factors of 2^degree - 1 from the per-degree cache.
+     * @details The first call for a degree factors the number and stores the result; later calls, from
+     *          any thread, return the stored factors.
+     * @param degree The degree, at most 64.
+     * @return The distinct prime factors of 2^degree - 1 in ascending order.
+     */
+    static const Vector(uint64)& orderPrimeFactors(uint32 degree);
+
+    /**
+     * @brief Drops the high zero words so that the top word, if any, is non-zero.
+     */
+    void normalize();
+
+    /**
+     * @brief Computes dst ^= src * x^shift in place.
+     * @details `dst` is grown only when the shifted `src` reaches past its current end, so
+     *          reducing a polynomial by its modulus never reallocates.
+     * @param dst The destination words.
+     * @param src The source words. Must be normalized.
+     * @param shift The number of bit positions to shift `src` by.
+     */
+    static void xorShifted(Vector(uint64)& dst, const Vector(uint64)& src, uint32 shift);
+
+    /**
+     * @brief The packed coefficients, lowest degree first.
+     *
+     * Bit j of words[i] is the coefficient of x^(64*i + j). The vector never ends in a zero word.
+     */
+    Vector(uint64) words;
+};
+
+#endif //CRYPTOGRAPHY1_GF2POLYNOMIAL_H
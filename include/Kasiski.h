@@ -0,0 +1,90 @@
+#ifndef CRYPTOGRAPHY1_KASISKI_H
+#define CRYPTOGRAPHY1_KASISKI_H
+
+#include "Types.h"
+
+/**
+ * @struct RepeatedSequence
+ * @brief A sequence that occurs more than once in a ciphertext.
+ */
+struct RepeatedSequence {
+    uint32 length;            ///< Length of the longest prefix shared by all occurrences.
+    Vector(uint32) positions; ///< Start of every occurrence, in increasing order.
+};
+
+/**
+ * @struct KasiskiResult
+ * @brief The outcome of a Kasiski examination.
+ */
+struct KasiskiResult {
+    Vector(RepeatedSequence) repeats; ///< Every left-maximal repeat, in suffix order.
+    Vector(uint64) factor_histogram;  ///< factor_histogram[f] counts the repeat spacings divisible by f.
+    uint32 key_length;                ///< The estimated key length, or 0 if nothing repeats.
+};
+
+/**
+ * @class Kasiski
+ * @brief Kasiski examination over a suffix array.
+ * @details The suffix array and its LCP array are built once. Every run of adjacent suffixes whose common
+ *          prefix is at least `min_length` long is one repeated sequence, so all repeats and their positions
+ *          come out of a single scan without materializing any substring. Runs that are only a one-character
+ *          shift of a longer repeat are skipped, so a long repeated passage is counted once rather than once
+ *          per offset. The spacings between consecutive occurrences of every repeat feed a factor histogram
+ *          instead of a GCD of the most frequent repeat only, which tolerates accidental repeats.
+ */
+class Kasiski {
+public:
+    /**
+     * @brief The largest key length considered by default.
+     */
+    static constexpr uint32 default_max_factor = 40;
+
+    /**
+     * @brief The fraction of the best factor's count that a larger factor needs to be preferred over it.
+     * @details Every divisor of the key length collects at least the key length's count, so the estimate is
+     *          the largest factor that is nearly as popular as the most popular one.
+     */
+    static constexpr float64 factor_tolerance = 0.8;
+
+    /**
+     * @brief Runs the Kasiski examination.
+     * @param message The ciphertext. Characters are compared as raw bytes.
+     * @param min_length The shortest repeat to consider. Must be positive.
+     * @param max_factor The largest spacing factor to count in the histogram.
+     * @return The repeats, the factor histogram and the key length estimate.
+     * @throws std::invalid_argument If `min_length` is 0.
+     * @throws std::length_error If the message is 2^32 characters or longer.
+     */
+    static KasiskiResult analyze(const String& message, uint32 min_length, uint32 max_factor = default_max_factor);
+
+    /**
+     * @brief Adds the factors of one spacing between two occurrences to a histogram.
+     * @param histogram The histogram, indexed by factor. Its size bounds the factors counted.
+     * @param distance The spacing.
+     */
+    static void addDistance(Vector(uint64)& histogram, uint64 distance);
+
+    /**
+     * @brief Picks the key length from a factor histogram.
+     * @param histogram The histogram, indexed by factor. Factors 0 and 1 are ignored.
+     * @return The largest factor whose count is within `factor_tolerance` of the highest, or 0 if all are 0.
+     */
+    static uint32 estimateKeyLength(const Vector(uint64)& histogram);
+
+    /**
+     * @brief Builds the suffix array by prefix doubling with radix sorts.
+     * @param text The text.
+     * @return The start positions of the suffixes of `text`, in lexicographic order.
+     */
+    static Vector(uint32) buildSuffixArray(const String& text);
+
+    /**
+     * @brief Builds the LCP array with Kasai's algorithm.
+     * @param text The text.
+     * @param suffix_array The suffix array of `text`.
+     * @return lcp[i] is the length of the common prefix of the suffixes at suffix_array[i - 1] and suffix_array[i]; lcp[0] is 0.
+     */
+    static Vector(uint32) buildLcpArray(const String& text, const Vector(uint32)& suffix_array);
+};
+
+#endif //CRYPTOGRAPHY1_KASISKI_H
@@ -0,0 +1,186 @@
+#ifndef CRYPTOGRAPHY1_LANGUAGEMODEL_H
+#define CRYPTOGRAPHY1_LANGUAGEMODEL_H
+
+#include "Types.h"
+
+/**
+ * @class LanguageModel
+ * @brief Letter n-gram statistics of a language, for scoring candidate plaintexts.
+ * @details A model holds log10 probability tables for some of the n-gram orders 1 to `max_order` over an
+ *          alphabet of letter indices, and the Index of Coincidence of the language. The table of order n
+ *          has alphabet_size^n entries; an n-gram is looked up as a number in base alphabet_size with the
+ *          first letter most significant.
+ *
+ *          Models are stored in a compact binary file: a 24-byte header (the magic "CRLM", the format
+ *          version, the alphabet size, a bit mask of the orders present and the Index of Coincidence as a
+ *          float64) followed by the tables as float32, lowest order first, all in native byte order. `load`
+ *          maps the file into memory instead of reading it, so opening a model costs no copying and every
+ *          process that analyzes with the same file shares its pages.
+ *
+ *          Built-in English and Greek models carry letter frequencies only. Higher orders come from model
+ *          files made by `LanguageModelBuilder` from a corpus.
+ */
+class LanguageModel {
+public:
+    /**
+     * @brief The highest n-gram order a model can hold.
+     */
+    static constexpr uint32 max_order = 4;
+
+    /**
+     * @brief Opens a model file by mapping it into memory.
+     * @details Falls back to reading the file on platforms without POSIX memory mapping.
+     * @param path The model file.
+     * @return The model, valid for as long as it lives.
+     * @throws std::runtime_error If the file cannot be opened or is not a valid model.
+     */
+    static LanguageModel load(const String& path);
+
+    /**
+     * @brief Parses a model from a buffer in the file format.
+     * @param bytes The model image.
+     * @return The model, which owns the buffer.
+     * @throws std::runtime_error If the buffer is not a valid model.
+     */
+    static LanguageModel fromBytes(Vector(uint8) bytes);
+
+    /**
+     * @brief Builds a unigram model from letter frequencies.
+     * @param frequencies The relative frequency of each letter. They do not need to sum to 1.
+     * @param expected_ic The Index of Coincidence of the language.
+     * @return The model.
+     * @throws std::invalid_argument If a frequency is not positive or the alphabet size is not supported.
+     */
+    static LanguageModel fromFrequencies(const Vector(float64)& frequencies, float64 expected_ic);
+
+    /**
+     * @brief The built-in English model, over the letter indices of `Utils::convertLettersToIndices`.
+     */
+    static const LanguageModel& english();
+
+    /**
+     * @brief The built-in Greek model, over the letter indices of `Utils::convertGreekLettersToIndices`.
+     */
+    static const LanguageModel& greek();
+
+    LanguageModel(LanguageModel&& other) noexcept;
+    LanguageModel& operator=(LanguageModel&& other) noexcept;
+    LanguageModel(const LanguageModel&) = delete;
+    LanguageModel& operator=(const LanguageModel&) = delete;
+    ~LanguageModel();
+
+    /**
+     * @brief Gets the number of letters. Index `alphabet_size` stands for any non-letter.
+     */
+    uint32 getAlphabetSize() const;
+
+    /**
+     * @brief Gets the Index of Coincidence of the language.
+     */
+    float64 getExpectedIC() const;
+
+    /**
+     * @brief Gets the highest n-gram order the model holds.
+     */
+    uint32 getMaxOrder() const;
+
+    /**
+     * @brief Gets the log10 probability table of an order.
+     * @param order The n-gram order, 1 to `max_order`.
+     * @return The table, or nullptr if the model does not hold that order.
+     */
+    const float32* getTable(uint32 order) const;
+
+    /**
+     * @brief Gets the relative frequency of every letter, from the unigram table.
+     * @return The frequencies, summing to 1.
+     * @throws std::logic_error If the model has no unigram table.
+     */
+    Vector(float64) getLetterFrequencies() const;
+
+    /**
+     * @brief Scores a text with the highest order the model holds.
+     * @see fitness(const uint8*, datatype_size, uint32) const
+     */
+    float64 fitness(const uint8* indices, datatype_size size) const;
+
+    /**
+     * @brief Scores a text by the log10 likelihood of its n-grams.
+     * @param indices The letter indices of the text. N-grams that contain a non-letter are skipped.
+     * @param size The number of indices.
+     * @param order The n-gram order to use.
+     * @return The sum of the log10 probabilities of all n-grams; higher is more like the language.
+     * @throws std::invalid_argument If the model does not hold that order.
+     */
+    float64 fitness(const uint8* indices, datatype_size size, uint32 order) const;
+
+private:
+    LanguageModel() = default;
+
+    /**
+     * @brief Validates a model image and points the tables into it.
+     */
+    void parse(const uint8* data, datatype_size size);
+
+    /**
+     * @brief Unmaps the file, if any.
+     */
+    void release();
+
+    void* mapping = nullptr;        ///< The mapped file, or nullptr if the image lives in `storage`.
+    datatype_size mapping_size = 0;
+    Vector(uint8) storage;
+    uint32 alphabet_size = 0;
+    float64 expected_ic = 0.0;
+    Array(const float32*, max_order + 1) tables = {}; ///< tables[n] is the order-n table, or nullptr.
+};
+
+/**
+ * @class LanguageModelBuilder
+ * @brief Counts letter n-grams of a training corpus and writes them as a `LanguageModel`.
+ * @details N-grams never seen get a floor of a hundredth of a single observation, so they are unlikely
+ *          but not impossible. The Index of Coincidence is measured on the corpus letters.
+ */
+class LanguageModelBuilder {
+public:
+    /**
+     * @brief Creates an empty builder.
+     * @param alphabet_size The number of letters, at most 255.
+     * @param orders The n-gram orders to build, each from 1 to `LanguageModel::max_order`.
+     * @throws std::invalid_argument If a parameter is out of range.
+     */
+    explicit LanguageModelBuilder(uint32 alphabet_size, const Vector(uint32)& orders = {1, 2, 4});
+
+    /**
+     * @brief Counts the n-grams of a stretch of corpus.
+     * @param indices The letter indices. Non-letters break n-grams.
+     * @param size The number of indices.
+     */
+    void addText(const uint8* indices, datatype_size size);
+
+    /**
+     * @brief Serializes the model in the file format.
+     * @return The model image.
+     */
+    Vector(uint8) serialize() const;
+
+    /**
+     * @brief Builds the model in memory.
+     */
+    LanguageModel build() const;
+
+    /**
+     * @brief Writes the model file.
+     * @param path The file to write.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void save(const String& path) const;
+
+private:
+    uint32 alphabet_size;
+    uint32 order_mask;                                          ///< Bit n is set if order n is built.
+    Array(Vector(uint64), LanguageModel::max_order + 1) counts; ///< counts[n] is empty unless order n is built or n is 1.
+    Array(uint64, LanguageModel::max_order + 1) totals = {};
+};
+
+#endif //CRYPTOGRAPHY1_LANGUAGEMODEL_H
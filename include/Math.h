@@ -35,6 +35,49 @@ public:
      * @return The average of the values. Returns 0.0 if the vector is empty.
      */
     static float64 average(const Vector(float64)& values);
+
+    /**
+     * @brief Checks if a number is prime.
+     * @details Uses a Miller-Rabin test with a fixed set of bases that is deterministic for all 64-bit inputs.
+     * @param number The number to test.
+     * @return True if the number is prime, false otherwise.
+     */
+    static bool isPrime(uint64 number);
+
+    /**
+     * @brief Finds the distinct prime factors of a number.
+     * @details Small factors are removed by trial division and whatever remains is split with Pollard's rho,
+     *          so numbers such as 2^64 - 1 factor in well under a millisecond.
+     * @param number The number to factor.
+     * @return The distinct prime factors in ascending order. Returns an empty vector for 0 and 1.
+     */
+    static Vector(uint64) findPrimeFactors(uint64 number);
+
+    /**
+     * @brief Computes (a * b) mod modulus without overflow.
+     * @param a The first factor.
+     * @param b The second factor.
+     * @param modulus The modulus. Must be non-zero.
+     * @return The product reduced modulo `modulus`.
+     */
+    static uint64 mulMod(uint64 a, uint64 b, uint64 modulus);
+
+    /**
+     * @brief Computes (base ^ exp) mod modulus by square-and-multiply.
+     * @param base The base.
+     * @param exp The exponent.
+     * @param modulus The modulus. Must be non-zero.
+     * @return The power reduced modulo `modulus`.
+     */
+    static uint64 powMod(uint64 base, uint64 exp, uint64 modulus);
+
+private:
+    /**
+     * @brief Finds a non-trivial factor of a composite number with Pollard's rho.
+     * @param number The composite number to split.
+     * @return A divisor of `number` strictly between 1 and `number`.
+     */
+    static uint64 findFactorPollardRho(uint64 number);
 };
 
 #endif //CRYPTOGRAPHY1_MATH_H
\ No newline at end of file
@@ -0,0 +1,549 @@
+#ifndef CRYPTOGRAPHY1_MODPOLYNOMIAL_H
+#define CRYPTOGRAPHY1_MODPOLYNOMIAL_H
+
+#include "Types.h"
+#include "Montgomery.h"
+#include "Polynomial.h"
+#include "GF2Polynomial.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+/**
+ * @brief Represents a polynomial with coefficients in Z/pZ.
+ *
+ * The coefficients are stored lowest degree first, in Montgomery form, in the word type of the field, so
+ * products never overflow and division is exact: the quotient's coefficients are multiplied by the inverse
+ * of the divisor's leading coefficient instead of being truncated by integer division. The zero polynomial
+ * has no coefficients and, like `Polynomial`, reports a degree of 0.
+ *
+ * ModPolynomial<StaticField<2>> is specialized to the bit-packed `GF2Polynomial`, so the GF(2) path
+ * keeps its carry-less kernels and adds no overhead.
+ *
+ * @tparam Field `StaticField<P>` for a compile-time modulus or `DynamicField<Word>` for a runtime one.
+ */
+template <typename Field>
+class ModPolynomial {
+public:
+    using Word = typename Field::Word;
+
+    /**
+     * @brief Constructs the zero polynomial.
+     * @param field The coefficient field.
+     */
+    explicit ModPolynomial(const Field& field = Field()) : field(field) {}
+
+    /**
+     * @brief Constructs a polynomial from standard coefficients.
+     * @param coeffs The coefficients, from lowest degree to highest. They are reduced modulo p.
+     * @param field The coefficient field.
+     */
+    ModPolynomial(const Vector(uint64)& coeffs, const Field& field = Field()) : field(field) {
+        coefficients.reserve(coeffs.size());
+        for (uint64 value : coeffs) {
+            coefficients.push_back(arithmetic().toMontgomery(value));
+        }
+        normalize();
+    }
+
+    /**
+     * @brief Reduces an integer polynomial modulo p.
+     * @param polynomial The polynomial to convert. Negative coefficients map to their positive residues.
+     * @param field The coefficient field.
+     * @return The reduced polynomial.
+     */
+    static ModPolynomial fromPolynomial(const Polynomial& polynomial, const Field& field = Field()) {
+        ModPolynomial result(field);
+        const uint64 modulus = result.arithmetic().getModulus();
+        for (int32 value : polynomial.getCoefficients()) {
+            const uint64 magnitude = static_cast<uint64>(value < 0 ? -static_cast<int64>(value) : value) % modulus;
+            const uint64 residue = value < 0 && magnitude != 0 ? modulus - magnitude : magnitude;
+            result.coefficients.push_back(result.arithmetic().toMontgomery(residue));
+        }
+        result.normalize();
+        return result;
+    }
+
+    /**
+     * @brief Converts to an integer polynomial with coefficients in [0, p).
+     * @return The equivalent `Polynomial`.
+     * @throws std::overflow_error If p - 1 does not fit in an int32.
+     */
+    Polynomial toPolynomial() const {
+        if (arithmetic().getModulus() - 1 > static_cast<uint64>(INT_MAX)) {
+            throw std::overflow_error("Coefficients do not fit in an int32 Polynomial");
+        }
+        Vector(int32) coeffs(getDegree() + 1, 0);
+        for (uint32 i = 0; i < coeffs.size(); ++i) {
+            coeffs[i] = static_cast<int32>(getCoefficient(i));
+        }
+        return Polynomial(std::move(coeffs), Polynomial::LowToHigh{});
+    }
+
+    /**
+     * @brief Gets the degree of the polynomial.
+     * @return The degree of the polynomial, or 0 for the zero polynomial.
+     */
+    uint32 getDegree() const {
+        return coefficients.empty() ? 0 : coefficients.size() - 1;
+    }
+
+    /**
+     * @brief Checks if the polynomial is zero.
+     * @return True if the polynomial is zero, false otherwise.
+     */
+    bool isZero() const {
+        return coefficients.empty();
+    }
+
+    /**
+     * @brief Gets a single coefficient.
+     * @param exponent The exponent of the term.
+     * @return The coefficient of x^exponent in [0, p).
+     */
+    uint64 getCoefficient(uint32 exponent) const {
+        return exponent < coefficients.size() ? arithmetic().fromMontgomery(coefficients[exponent]) : 0;
+    }
+
+    /**
+     * @brief Gets all coefficients in standard form.
+     * @return The coefficients, from lowest degree to highest.
+     */
+    Vector(uint64) getCoefficients() const {
+        Vector(uint64) result;
+        result.reserve(coefficients.size());
+        for (Word value : coefficients) {
+            result.push_back(arithmetic().fromMontgomery(value));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Gets the coefficient field.
+     * @return A const reference to the field.
+     */
+    const Field& getField() const {
+        return field;
+    }
+
+    /**
+     * @brief Converts the polynomial to a string representation.
+     * @return A string representation of the polynomial.
+     */
+    String toString() const {
+        if (isZero()) {
+            return "0";
+        }
+        String result;
+        for (uint32 i = getDegree() + 1; i-- > 0;) {
+            const uint64 value = getCoefficient(i);
+            if (value == 0) {
+                continue;
+            }
+            if (!result.empty()) {
+                result += " + ";
+            }
+            if (value != 1 || i == 0) {
+                result += std::to_string(value);
+            }
+            if (i > 0) {
+                result += "x";
+                if (i > 1) {
+                    result += '^';
+                    result += std::to_string(i);
+                }
+            }
+        }
+        return result;
+    }
+
+    ModPolynomial& operator+=(const ModPolynomial& other) {
+        checkField(other);
+        if (other.coefficients.size() > coefficients.size()) {
+            coefficients.resize(other.coefficients.size(), 0);
+        }
+        for (datatype_size i = 0; i < other.coefficients.size(); ++i) {
+            coefficients[i] = arithmetic().add(coefficients[i], other.coefficients[i]);
+        }
+        normalize();
+        return *this;
+    }
+
+    ModPolynomial& operator-=(const ModPolynomial& other) {
+        checkField(other);
+        if (other.coefficients.size() > coefficients.size()) {
+            coefficients.resize(other.coefficients.size(), 0);
+        }
+        for (datatype_size i = 0; i < other.coefficients.size(); ++i) {
+            coefficients[i] = arithmetic().subtract(coefficients[i], other.coefficients[i]);
+        }
+        normalize();
+        return *this;
+    }
+
+    ModPolynomial& operator*=(const ModPolynomial& other) {
+        *this = *this * other;
+        return *this;
+    }
+
+    ModPolynomial& operator/=(const ModPolynomial& other) {
+        ModPolynomial quotient(field);
+        divide(*this, other, &quotient, nullptr);
+        *this = std::move(quotient);
+        return *this;
+    }
+
+    ModPolynomial& operator%=(const ModPolynomial& other) {
+        divide(*this, other, nullptr, this);
+        return *this;
+    }
+
+    ModPolynomial operator+(const ModPolynomial& other) const {
+        ModPolynomial result = *this;
+        result += other;
+        return result;
+    }
+
+    ModPolynomial operator-(const ModPolynomial& other) const {
+        ModPolynomial result = *this;
+        result -= other;
+        return result;
+    }
+
+    /**
+     * @brief Overloads the multiplication operator, switching to Karatsuba for long operands.
+     * @param other The polynomial to multiply by.
+     * @return A new polynomial representing the product.
+     */
+    ModPolynomial operator*(const ModPolynomial& other) const {
+        checkField(other);
+        ModPolynomial result(field);
+        if (isZero() || other.isZero()) {
+            return result;
+        }
+        result.coefficients = multiplyCoefficients(coefficients, other.coefficients);
+        result.normalize();
+        return result;
+    }
+
+    ModPolynomial operator/(const ModPolynomial& other) const {
+        ModPolynomial quotient(field);
+        divide(*this, other, &quotient, nullptr);
+        return quotient;
+    }
+
+    ModPolynomial operator%(const ModPolynomial& other) const {
+        ModPolynomial remainder(field);
+        divide(*this, other, nullptr, &remainder);
+        return remainder;
+    }
+
+    bool operator==(const ModPolynomial& other) const {
+        return field == other.field && coefficients == other.coefficients;
+    }
+
+    bool operator!=(const ModPolynomial& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Performs exact polynomial long division.
+     * @param dividend The dividend.
+     * @param divisor The divisor.
+     * @param quotient Receives the quotient if not null.
+     * @param remainder Receives the remainder if not null. May alias `dividend`.
+     * @throws std::invalid_argument If the divisor is zero.
+     * @throws std::domain_error If the divisor's leading coefficient is not invertible modulo p.
+     */
+    static void divide(const ModPolynomial& dividend, const ModPolynomial& divisor,
+                       ModPolynomial* quotient, ModPolynomial* remainder) {
+        dividend.checkField(divisor);
+        if (divisor.isZero()) {
+            throw std::invalid_argument("Division by zero polynomial");
+        }
+
+        const Montgomery<Word>& ops = dividend.arithmetic();
+        Vector(Word) rest = dividend.coefficients;
+        const datatype_size divisor_size = divisor.coefficients.size();
+        const Word lead_inverse = ops.inverse(divisor.coefficients.back());
+
+        Vector(Word) quotient_coeffs(rest.size() >= divisor_size ? rest.size() - divisor_size + 1 : 0, 0);
+        for (datatype_size shift = quotient_coeffs.size(); shift-- > 0;) {
+            const Word factor = ops.multiply(rest[shift + divisor_size - 1], lead_inverse);
+            quotient_coeffs[shift] = factor;
+            if (factor == 0) {
+                continue;
+            }
+            for (datatype_size i = 0; i < divisor_size; ++i) {
+                rest[shift + i] = ops.subtract(rest[shift + i], ops.multiply(factor, divisor.coefficients[i]));
+            }
+        }
+
+        if (quotient != nullptr) {
+            quotient->field = dividend.field;
+            quotient->coefficients = std::move(quotient_coeffs);
+            quotient->normalize();
+        }
+        if (remainder != nullptr) {
+            remainder->field = dividend.field;
+            remainder->coefficients = std::move(rest);
+            remainder->normalize();
+        }
+    }
+
+    /**
+     * @brief Performs modular exponentiation.
+     * @param base The base polynomial.
+     * @param exp The exponent.
+     * @param mod The modulus polynomial.
+     * @return The result of (base^exp) mod mod.
+     */
+    static ModPolynomial powerMod(const ModPolynomial& base, uint64 exp, const ModPolynomial& mod) {
+        ModPolynomial result(Vector(uint64){1}, base.field);
+        result %= mod;
+        ModPolynomial b = base % mod;
+        while (exp > 0) {
+            if (exp % 2 == 1) {
+                result = result * b % mod;
+            }
+            b = b * b % mod;
+            exp /= 2;
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief The operand size from which multiplication switches from schoolbook to Karatsuba.
+     */
+    static constexpr datatype_size karatsuba_threshold = 32;
+
+    const Montgomery<Word>& arithmetic() const {
+        return field.get();
+    }
+
+    void checkField(const ModPolynomial& other) const {
+        if (!(field == other.field)) {
+            throw std::invalid_argument("Polynomials are defined over different moduli");
+        }
+    }
+
+    void normalize() {
+        while (!coefficients.empty() && coefficients.back() == 0) {
+            coefficients.pop_back();
+        }
+    }
+
+    static datatype_size karatsubaScratchSize(datatype_size size) {
+        datatype_size total = 0;
+        while (size >= karatsuba_threshold) {
+            const datatype_size high = size - size / 2;
+            total += 4 * high;
+            size = high;
+        }
+        return total;
+    }
+
+    void schoolbook(const Word* a, datatype_size a_size, const Word* b, datatype_size b_size, Word* out) const {
+        // A local copy, since stores through `out` could otherwise alias the modulus and force reloads.
+        const Montgomery<Word> ops = arithmetic();
+        std::fill(out, out + a_size + b_size, 0);
+        for (datatype_size i = 0; i < a_size; ++i) {
+            const Word factor = a[i];
+            if (factor == 0) {
+                continue;
+            }
+            for (datatype_size j = 0; j < b_size; ++j) {
+                out[i + j] = ops.add(out[i + j], ops.multiply(factor, b[j]));
+            }
+        }
+    }
+
+    /**
+     * @brief Multiplies two operands of `size` coefficients into `out`, which holds 2 * size.
+     * @details `scratch` holds `karatsubaScratchSize(size)` words and is shared by every level of the recursion.
+     */
+    void karatsuba(const Word* a, const Word* b, datatype_size size, Word* out, Word* scratch) const {
+        if (size < karatsuba_threshold) {
+            schoolbook(a, size, b, size, out);
+            return;
+        }
+
+        const Montgomery<Word>& ops = arithmetic();
+        const datatype_size low = size / 2;
+        const datatype_size high = size - low;
+
+        karatsuba(a, b, low, out, scratch);
+        karatsuba(a + low, b + low, high, out + 2 * low, scratch);
+
+        Word* a_sum = scratch;
+        Word* b_sum = scratch + high;
+        Word* middle = scratch + 2 * high;
+        for (datatype_size i = 0; i < high; ++i) {
+            a_sum[i] = i < low ? ops.add(a[low + i], a[i]) : a[low + i];
+            b_sum[i] = i < low ? ops.add(b[low + i], b[i]) : b[low + i];
+        }
+
+        // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+        karatsuba(a_sum, b_sum, high, middle, scratch + 4 * high);
+        for (datatype_size i = 0; i < 2 * low; ++i) {
+            middle[i] = ops.subtract(middle[i], out[i]);
+        }
+        for (datatype_size i = 0; i < 2 * high; ++i) {
+            middle[i] = ops.subtract(middle[i], out[2 * low + i]);
+        }
+        for (datatype_size i = 0; i < 2 * high; ++i) {
+            out[low + i] = ops.add(out[low + i], middle[i]);
+        }
+    }
+
+    Vector(Word) multiplyCoefficients(const Vector(Word)& a, const Vector(Word)& b) const {
+        const Vector(Word)& longer = a.size() >= b.size() ? a : b;
+        const Vector(Word)& shorter = a.size() >= b.size() ? b : a;
+        if (shorter.size() < karatsuba_threshold) {
+            Vector(Word) result(a.size() + b.size(), 0);
+            schoolbook(longer.data(), longer.size(), shorter.data(), shorter.size(), result.data());
+            result.pop_back();
+            return result;
+        }
+
+        // Cut the longer operand into blocks as long as the shorter one and run a balanced Karatsuba per block.
+        const Montgomery<Word>& ops = arithmetic();
+        const datatype_size block = shorter.size();
+        Vector(Word) padded(block, 0);
+        Vector(Word) product(2 * block, 0);
+        Vector(Word) scratch(karatsubaScratchSize(block), 0);
+        Vector(Word) result(longer.size() + block, 0);
+
+        for (datatype_size offset = 0; offset < longer.size(); offset += block) {
+            const datatype_size length = std::min(block, longer.size() - offset);
+            const Word* lhs = longer.data() + offset;
+            if (length < block) {
+                std::copy(lhs, lhs + length, padded.begin());
+                std::fill(padded.begin() + length, padded.end(), 0);
+                lhs = padded.data();
+            }
+            karatsuba(lhs, shorter.data(), block, product.data(), scratch.data());
+
+            const datatype_size limit = std::min(2 * block, result.size() - offset);
+            for (datatype_size i = 0; i < limit; ++i) {
+                result[offset + i] = ops.add(result[offset + i], product[i]);
+            }
+        }
+
+        result.resize(a.size() + b.size() - 1);
+        return result;
+    }
+
+    [[no_unique_address]] Field field;
+    Vector(Word) coefficients; ///< Montgomery-form coefficients, lowest degree first, no high zeros.
+};
+
+/**
+ * @brief Polynomials over GF(2) are the bit-packed `GF2Polynomial`, with no extra state or indirection.
+ * @details Offers the interface of the primary template as thin wrappers over the `GF2Polynomial` kernels,
+ *          so code written against `ModPolynomial<Field>` works unchanged for GF(2). Coefficients are 0 or 1.
+ */
+template <>
+class ModPolynomial<GF2Field> : public GF2Polynomial {
+public:
+    using Word = uint64;
+
+    using GF2Polynomial::GF2Polynomial;
+
+    explicit ModPolynomial(const GF2Field& = GF2Field()) {}
+
+    ModPolynomial(const Vector(uint64)& coeffs, const GF2Field& = GF2Field()) {
+        for (uint32 i = 0; i < coeffs.size(); ++i) {
+            setCoefficient(i, coeffs[i] % 2 != 0);
+        }
+    }
+
+    ModPolynomial(const GF2Polynomial& polynomial) : GF2Polynomial(polynomial) {}
+
+    ModPolynomial(GF2Polynomial&& polynomial) : GF2Polynomial(std::move(polynomial)) {}
+
+    static ModPolynomial fromPolynomial(const Polynomial& polynomial, const GF2Field& = GF2Field()) {
+        return ModPolynomial(GF2Polynomial(polynomial));
+    }
+
+    uint64 getCoefficient(uint32 exponent) const {
+        return GF2Polynomial::getCoefficient(exponent) ? 1 : 0;
+    }
+
+    Vector(Word) getCoefficients() const {
+        Vector(Word) result(isZero() ? 0 : getDegree() + 1, 0);
+        for (uint32 i = 0; i < result.size(); ++i) {
+            result[i] = getCoefficient(i);
+        }
+        return result;
+    }
+
+    GF2Field getField() const {
+        return GF2Field();
+    }
+
+    ModPolynomial& operator+=(const ModPolynomial& other) {
+        GF2Polynomial::operator+=(other);
+        return *this;
+    }
+
+    /**
+     * @brief Subtraction is addition in characteristic 2.
+     */
+    ModPolynomial& operator-=(const ModPolynomial& other) {
+        GF2Polynomial::operator+=(other);
+        return *this;
+    }
+
+    ModPolynomial& operator*=(const ModPolynomial& other) {
+        GF2Polynomial::operator*=(other);
+        return *this;
+    }
+
+    ModPolynomial& operator/=(const ModPolynomial& other) {
+        GF2Polynomial::divide(*this, other, this, nullptr);
+        return *this;
+    }
+
+    ModPolynomial& operator%=(const ModPolynomial& other) {
+        GF2Polynomial::operator%=(other);
+        return *this;
+    }
+
+    ModPolynomial operator+(const ModPolynomial& other) const {
+        return GF2Polynomial::operator+(other);
+    }
+
+    ModPolynomial operator-(const ModPolynomial& other) const {
+        return GF2Polynomial::operator+(other);
+    }
+
+    ModPolynomial operator*(const ModPolynomial& other) const {
+        return GF2Polynomial::operator*(other);
+    }
+
+    ModPolynomial operator/(const ModPolynomial& other) const {
+        ModPolynomial quotient;
+        GF2Polynomial::divide(*this, other, &quotient, nullptr);
+        return quotient;
+    }
+
+    ModPolynomial operator%(const ModPolynomial& other) const {
+        return GF2Polynomial::operator%(other);
+    }
+
+    /**
+     * @brief Performs exact polynomial long division. See `GF2Polynomial::divide`.
+     */
+    static void divide(const ModPolynomial& dividend, const ModPolynomial& divisor,
+                       ModPolynomial* quotient, ModPolynomial* remainder) {
+        GF2Polynomial::divide(dividend, divisor, quotient, remainder);
+    }
+
+    static ModPolynomial powerMod(const ModPolynomial& base, uint64 exp, const ModPolynomial& mod) {
+        return GF2Polynomial::powerMod(base, exp, mod);
+    }
+};
+
+#endif //CRYPTOGRAPHY1_MODPOLYNOMIAL_H
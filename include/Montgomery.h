@@ -0,0 +1,250 @@
+#ifndef CRYPTOGRAPHY1_MONTGOMERY_H
+#define CRYPTOGRAPHY1_MONTGOMERY_H
+
+#include "Types.h"
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Maps a word type to the type that holds the product of two words.
+ */
+template <typename Word>
+struct MontgomeryWide;
+
+template <>
+struct MontgomeryWide<uint32> {
+    using type = uint64;
+};
+
+template <>
+struct MontgomeryWide<uint64> {
+    using type = unsigned __int128;
+};
+
+/**
+ * @class Montgomery
+ * @brief Modular arithmetic modulo an odd number in Montgomery form.
+ *
+ * A value a is stored as a * R mod n, with R = 2^32 or 2^64 depending on the word type, so that a modular
+ * product only needs two word multiplications and a shift instead of a division. Every operation returns
+ * a fully reduced value in [0, n), and no intermediate can overflow for any odd modulus that fits the word.
+ * The constructor is constexpr, so a fixed modulus can be precomputed at compile time.
+ *
+ * @tparam WordType uint32 or uint64.
+ */
+template <typename WordType>
+class Montgomery {
+public:
+    using Word = WordType;
+    using Wide = typename MontgomeryWide<Word>::type;
+
+    static constexpr uint32 word_bits = sizeof(Word) * 8;
+
+    /**
+     * @brief Precomputes the Montgomery constants for a modulus.
+     * @param modulus The modulus. Must be odd and at least 3.
+     * @throws std::invalid_argument If the modulus is even or smaller than 3.
+     */
+    constexpr explicit Montgomery(Word modulus) : modulus(modulus), modulus_inverse(0), r_squared(0) {
+        if (modulus < 3 || modulus % 2 == 0) {
+            throw std::invalid_argument("Montgomery arithmetic needs an odd modulus of at least 3");
+        }
+        // Newton's iteration for n^-1 mod 2^w; n * n = 1 mod 8 gives three correct bits to start from.
+        Word inverse = modulus;
+        for (uint32 i = 0; i < 5; ++i) {
+            inverse *= 2 - modulus * inverse;
+        }
+        modulus_inverse = inverse;
+
+        const Word r = static_cast<Word>(0 - modulus) % modulus;
+        r_squared = static_cast<Word>(static_cast<Wide>(r) * r % modulus);
+    }
+
+    /**
+     * @brief Gets the modulus.
+     * @return The modulus n.
+     */
+    constexpr Word getModulus() const {
+        return modulus;
+    }
+
+    /**
+     * @brief Converts a standard value to Montgomery form.
+     * @param value The value, which need not be reduced.
+     * @return value * R mod n.
+     */
+    constexpr Word toMontgomery(uint64 value) const {
+        return reduce(static_cast<Wide>(static_cast<Word>(value % modulus)) * r_squared);
+    }
+
+    /**
+     * @brief Converts a value in Montgomery form back to a standard value.
+     * @param value The value in Montgomery form.
+     * @return The standard representative in [0, n).
+     */
+    constexpr Word fromMontgomery(Word value) const {
+        return reduce(value);
+    }
+
+    constexpr Word zero() const {
+        return 0;
+    }
+
+    constexpr Word one() const {
+        return toMontgomery(1);
+    }
+
+    constexpr Word add(Word a, Word b) const {
+        const Word sum = a + b;
+        return (sum < a || sum >= modulus) ? sum - modulus : sum;
+    }
+
+    constexpr Word subtract(Word a, Word b) const {
+        return a >= b ? a - b : a + (modulus - b);
+    }
+
+    constexpr Word negate(Word a) const {
+        return a == 0 ? 0 : modulus - a;
+    }
+
+    constexpr Word multiply(Word a, Word b) const {
+        return reduce(static_cast<Wide>(a) * b);
+    }
+
+    /**
+     * @brief Computes a^exp in Montgomery form.
+     * @param a The base, in Montgomery form.
+     * @param exp The exponent.
+     * @return a^exp, in Montgomery form.
+     */
+    constexpr Word power(Word a, uint64 exp) const {
+        Word result = one();
+        while (exp > 0) {
+            if (exp % 2 == 1) {
+                result = multiply(result, a);
+            }
+            a = multiply(a, a);
+            exp /= 2;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the multiplicative inverse with the extended Euclidean algorithm.
+     * @param a The value to invert, in Montgomery form.
+     * @return a^-1, in Montgomery form.
+     * @throws std::domain_error If a shares a factor with the modulus.
+     */
+    constexpr Word inverse(Word a) const {
+        using Signed = std::conditional_t<sizeof(Word) == 4, int64, __int128>;
+        Signed old_r = fromMontgomery(a), r = modulus;
+        Signed old_s = 1, s = 0;
+        while (r != 0) {
+            const Signed quotient = old_r / r;
+            Signed next = old_r - quotient * r;
+            old_r = r;
+            r = next;
+            next = old_s - quotient * s;
+            old_s = s;
+            s = next;
+        }
+        if (old_r != 1) {
+            throw std::domain_error("Value is not invertible modulo the modulus");
+        }
+        if (old_s < 0) {
+            old_s += modulus;
+        }
+        return toMontgomery(static_cast<uint64>(old_s));
+    }
+
+    constexpr bool operator==(const Montgomery& other) const {
+        return modulus == other.modulus;
+    }
+
+private:
+    /**
+     * @brief Montgomery reduction: computes t * R^-1 mod n for t < n * R.
+     * @details With m = t * n^-1 mod R, t - m * n is divisible by R and its low words cancel, so only the
+     *          high words are subtracted and no wider-than-Wide intermediate is needed.
+     */
+    constexpr Word reduce(Wide t) const {
+        const Word m = static_cast<Word>(t) * modulus_inverse;
+        const Word t_high = static_cast<Word>(t >> word_bits);
+        const Word mn_high = static_cast<Word>((static_cast<Wide>(m) * modulus) >> word_bits);
+        return t_high >= mn_high ? t_high - mn_high : t_high + (modulus - mn_high);
+    }
+
+    Word modulus;
+    Word modulus_inverse; ///< n^-1 mod R.
+    Word r_squared;       ///< R^2 mod n, used to enter Montgomery form.
+};
+
+/**
+ * @struct StaticField
+ * @brief The field Z/PZ with a modulus fixed at compile time.
+ * @details The Montgomery constants are computed by the compiler and the struct itself is empty, so a
+ *          polynomial over it carries no per-object field state. StaticField<2> is a plain tag: GF(2) has
+ *          its own bit-packed representation, see `ModPolynomial<StaticField<2>>`.
+ * @tparam P The modulus, odd (or 2).
+ * @tparam WordType The storage word, uint32 for moduli below 2^32 and uint64 otherwise by default.
+ */
+template <uint64 P, typename WordType = std::conditional_t<(P < (1ULL << 32)), uint32, uint64>>
+struct StaticField {
+    using Word = WordType;
+    static constexpr Montgomery<Word> arithmetic{static_cast<Word>(P)};
+
+    constexpr const Montgomery<Word>& get() const {
+        return arithmetic;
+    }
+
+    constexpr bool operator==(const StaticField&) const {
+        return true;
+    }
+};
+
+template <typename WordType>
+struct StaticField<2, WordType> {
+};
+
+/**
+ * @brief The field GF(2), whose polynomials are `GF2Polynomial`s.
+ */
+using GF2Field = StaticField<2>;
+
+/**
+ * @class DynamicField
+ * @brief The ring Z/nZ with a modulus chosen at runtime.
+ * @tparam WordType uint32 or uint64.
+ */
+template <typename WordType>
+class DynamicField {
+public:
+    using Word = WordType;
+
+    /**
+     * @brief Creates the field for a modulus.
+     * @param modulus The modulus. Must be odd, at least 3 and fit in the word type.
+     * @throws std::invalid_argument If the modulus is not usable.
+     */
+    explicit DynamicField(uint64 modulus) : arithmetic(checkedModulus(modulus)) {}
+
+    const Montgomery<Word>& get() const {
+        return arithmetic;
+    }
+
+    bool operator==(const DynamicField& other) const {
+        return arithmetic == other.arithmetic;
+    }
+
+private:
+    static Word checkedModulus(uint64 modulus) {
+        if (modulus > static_cast<uint64>(static_cast<Word>(~static_cast<Word>(0)))) {
+            throw std::invalid_argument("Modulus does not fit in the coefficient word");
+        }
+        return static_cast<Word>(modulus);
+    }
+
+    Montgomery<Word> arithmetic;
+};
+
+#endif //CRYPTOGRAPHY1_MONTGOMERY_H
@@ -0,0 +1,73 @@
+#ifndef CRYPTOGRAPHY1_PARALLELAES_H
+#define CRYPTOGRAPHY1_PARALLELAES_H
+
+#include "Types.h"
+#include <span>
+
+class ThreadPool;
+
+/**
+ * @class ParallelAes
+ * @brief Multi-threaded AES-128 for the modes whose blocks can be processed independently.
+ * @details In CTR mode block i is the data XORed with the encryption of counter IV + i, and in CBC decryption
+ *          plaintext block i is the decryption of ciphertext block i XORed with ciphertext block i - 1. Neither
+ *          depends on the output of earlier blocks, so a large buffer is split into one block-aligned segment
+ *          per worker. Each segment is processed by its own `AesContext`, started from IV + offset / 16 for CTR
+ *          or from the ciphertext block just before the segment for CBC, and written straight into its part of
+ *          the output. CBC and ECB encryption chain through their outputs and are not offered here.
+ *
+ *          Buffers shorter than two segments of `min_segment_size` run on the calling thread.
+ */
+class ParallelAes {
+public:
+    /**
+     * @brief The smallest segment handed to one worker. Smaller segments would not pay for the task overhead.
+     */
+    static constexpr datatype_size min_segment_size = 1 << 16;
+
+    /**
+     * @brief Encrypts or decrypts a buffer in CTR mode. Both are the same operation.
+     * @param key The 16-byte key.
+     * @param iv The 16-byte initial counter block, incremented as a 128-bit big-endian integer.
+     * @param input The data.
+     * @param output The destination, at least `input.size()` bytes. May be `input` itself but must not overlap it
+     *               otherwise.
+     * @param pool The pool that runs the segments.
+     * @throws std::length_error If the key or the IV is not 16 bytes.
+     * @throws std::invalid_argument If `output` is too small.
+     * @throws std::runtime_error If OpenSSL fails.
+     */
+    static void ctr(const String& key, const String& iv, std::span<const uint8> input, std::span<uint8> output,
+                    ThreadPool& pool);
+
+    /**
+     * @brief Decrypts a PKCS#7 padded CBC ciphertext, such as one produced by `Crypto::encryptCBC`.
+     * @param key The 16-byte key.
+     * @param iv The 16-byte IV used for encryption.
+     * @param input The ciphertext, a positive whole number of blocks.
+     * @param output The destination, at least `input.size()` bytes. Must not overlap `input`, whose blocks serve
+     *               as the IVs of the following segments.
+     * @param pool The pool that runs the segments.
+     * @return The plaintext size, with the padding removed.
+     * @throws std::length_error If the key or the IV is not 16 bytes.
+     * @throws std::invalid_argument If the ciphertext is not a positive whole number of blocks or `output` is too
+     *                               small.
+     * @throws std::runtime_error If OpenSSL fails or the padding is invalid.
+     */
+    static datatype_size decryptCBC(const String& key, const String& iv, std::span<const uint8> input,
+                                    std::span<uint8> output, ThreadPool& pool);
+
+private:
+    /**
+     * @brief Adds a block count to a 16-byte big-endian counter.
+     */
+    static String addToCounter(const String& counter, uint64 blocks);
+
+    /**
+     * @brief Splits a buffer into block-aligned segments, at most one per worker.
+     * @return The segment boundaries: segment i is [result[i], result[i + 1]).
+     */
+    static Vector(datatype_size) splitSegments(datatype_size size, uint32 thread_count);
+};
+
+#endif //CRYPTOGRAPHY1_PARALLELAES_H
@@ -22,22 +22,80 @@ public:
      */
     Polynomial(uint32 deg, const Vector(int32)& coeffs);
 
+    /**
+     * @brief Tag selecting the constructor that takes coefficients in internal order.
+     */
+    struct LowToHigh {};
+
+    /**
+     * @brief Constructs a new Polynomial object from coefficients in internal order, without copying them.
+     * @param coeffs A vector of int32 coefficients, from lowest degree to highest. The degree is its size
+     *               minus one, or 0 if it is empty.
+     */
+    Polynomial(Vector(int32)&& coeffs, LowToHigh);
+
+    /**
+     * @brief Adds a polynomial in place.
+     * @param other The polynomial to add.
+     * @return A reference to this polynomial.
+     */
+    Polynomial& operator+=(const Polynomial& other);
+
+    /**
+     * @brief Subtracts a polynomial in place.
+     * @param other The polynomial to subtract.
+     * @return A reference to this polynomial.
+     */
+    Polynomial& operator-=(const Polynomial& other);
+
+    /**
+     * @brief Multiplies by a polynomial in place.
+     * @param other The polynomial to multiply by.
+     * @return A reference to this polynomial.
+     */
+    Polynomial& operator*=(const Polynomial& other);
+
+    /**
+     * @brief Replaces this polynomial with its quotient by another.
+     * @param other The polynomial to divide by.
+     * @return A reference to this polynomial.
+     */
+    Polynomial& operator/=(const Polynomial& other);
+
+    /**
+     * @brief Replaces this polynomial with its remainder by another, reducing the coefficients in place.
+     * @param other The polynomial to divide by.
+     * @return A reference to this polynomial.
+     */
+    Polynomial& operator%=(const Polynomial& other);
+
     /**
      * @brief Overloads the addition operator for polynomials.
      * @param other The polynomial to add.
      * @return A new polynomial representing the sum.
      */
-    Polynomial operator+(const Polynomial& other) const;
+    Polynomial operator+(const Polynomial& other) const&;
+
+    /**
+     * @brief Adds to a temporary, reusing its coefficient buffer.
+     */
+    Polynomial operator+(const Polynomial& other) &&;
 
     /**
      * @brief Overloads the subtraction operator for polynomials.
      * @param other The polynomial to subtract.
      * @return A new polynomial representing the difference.
      */
-    Polynomial operator-(const Polynomial& other) const;
+    Polynomial operator-(const Polynomial& other) const&;
+
+    /**
+     * @brief Subtracts from a temporary, reusing its coefficient buffer.
+     */
+    Polynomial operator-(const Polynomial& other) &&;
 
     /**
      * @brief Overloads the multiplication operator for polynomials.
+     * @details Dispatches to schoolbook, Karatsuba or NTT multiplication by size, see `Convolution`.
      * @param other The polynomial to multiply by.
      * @return A new polynomial representing the product.
      */
@@ -45,6 +103,8 @@ public:
 
     /**
      * @brief Overloads the division operator for polynomials (returns quotient).
+     * @details When the divisor's leading coefficient is 1 or -1 and the quotient is long, the quotient is
+     *          computed by Newton iteration on the reversed polynomials instead of long division.
      * @param other The polynomial to divide by.
      * @return A new polynomial representing the quotient.
      */
@@ -55,7 +115,12 @@ public:
      * @param other The polynomial to divide by.
      * @return A new polynomial representing the remainder.
      */
-    Polynomial operator%(const Polynomial& other) const;
+    Polynomial operator%(const Polynomial& other) const&;
+
+    /**
+     * @brief Reduces a temporary in place, reusing its coefficient buffer.
+     */
+    Polynomial operator%(const Polynomial& other) &&;
 
     /**
      * @brief Gets the degree of the polynomial.
@@ -125,7 +190,40 @@ private:
      * @param mod The modulus polynomial.
      * @return The result of (base^exp) mod mod over GF(2).
      */
-    static Polynomial gf2Power(const Polynomial& base, uint32 exp, const Polynomial& mod);
+    static Polynomial gf2Power(const Polynomial& base, uint64 exp, const Polynomial& mod);
+
+    /**
+     * @brief The quotient length from which division by a divisor with a unit leading coefficient uses Newton iteration.
+     */
+    static constexpr uint32 newton_division_threshold = 64;
+
+    /**
+     * @brief Checks if dividing by `divisor` should use Newton iteration.
+     * @param divisor The divisor polynomial. Must not have a higher degree than this one.
+     * @return True if the divisor's leading coefficient is 1 or -1 and the quotient is long enough.
+     */
+    bool usesNewtonDivision(const Polynomial& divisor) const;
+
+    /**
+     * @brief Computes the quotient by a divisor with a unit leading coefficient using Newton iteration.
+     * @param divisor The divisor polynomial.
+     * @return The quotient coefficients, from lowest degree to highest.
+     */
+    Vector(int32) newtonQuotient(const Polynomial& divisor) const;
+
+    /**
+     * @brief Runs long division in place, leaving the remainder in this polynomial.
+     * @details Each step subtracts a multiple of the shifted divisor directly from the coefficients. The
+     *          loop stops once the leading coefficient is not divisible by the divisor's.
+     * @param divisor The divisor polynomial. Must not be zero.
+     * @param quotient Receives the quotient coefficients, from lowest degree to highest, if not null.
+     */
+    void longDivide(const Polynomial& divisor, Vector(int32)* quotient);
+
+    /**
+     * @brief Drops zero leading coefficients, keeping at least the constant term.
+     */
+    void trim();
 
     /**
      * @brief The degree of the polynomial.
@@ -0,0 +1,76 @@
+#ifndef CRYPTOGRAPHY1_PRIMITIVEPOLYNOMIALSEARCH_H
+#define CRYPTOGRAPHY1_PRIMITIVEPOLYNOMIALSEARCH_H
+
+#include "Types.h"
+#include "GF2Polynomial.h"
+#include "ThreadPool.h"
+#include <functional>
+
+/**
+ * @struct PrimitiveSearchOptions
+ * @brief Describes which primitive polynomials a `PrimitivePolynomialSearch` should enumerate.
+ */
+struct PrimitiveSearchOptions {
+    uint32 degree = 0;                ///< The degree of the polynomials, between 1 and 63.
+    Vector(uint32) weights;           ///< Allowed numbers of terms, e.g. {3, 5} for trinomials and pentanomials. Empty allows any.
+    uint64 chunk_size = 4096;         ///< Number of candidates handed to a worker at a time.
+    uint32 progress_interval_ms = 1000; ///< Minimum time between two progress reports.
+};
+
+/**
+ * @struct PrimitiveSearchProgress
+ * @brief A snapshot of a running search, passed to the progress callback.
+ */
+struct PrimitiveSearchProgress {
+    uint64 tested;                  ///< Candidates examined so far, including those rejected by the filters.
+    uint64 total;                   ///< Size of the candidate space, 2^(degree - 1).
+    uint64 found;                   ///< Primitive polynomials reported so far.
+    float64 candidates_per_second;  ///< Average throughput since the search started.
+};
+
+/**
+ * @class PrimitivePolynomialSearch
+ * @brief Enumerates every primitive polynomial of a given degree over GF(2) on a thread pool.
+ * @details A primitive polynomial of degree m has the form x^m + ... + 1, so the candidates are the
+ *          2^(m-1) choices of the middle coefficients. The candidate space is cut into chunks that run as
+ *          pool tasks and are balanced by the pool's work stealing. Cheap filters on the packed bits
+ *          (requested weight, odd weight, no factor of degree 2 to 4) reject most candidates before the full
+ *          Rabin and order tests. Results are delivered on the calling thread in ascending order of the
+ *          candidate bits, even though chunks finish out of order.
+ */
+class PrimitivePolynomialSearch {
+public:
+    using ResultCallback = std::function<void(const GF2Polynomial&)>;
+    using ProgressCallback = std::function<void(const PrimitiveSearchProgress&)>;
+
+    /**
+     * @brief Runs the search and streams every primitive polynomial to a callback.
+     * @param options The degree, weight filter and scheduling parameters.
+     * @param pool The thread pool to run the chunks on.
+     * @param on_result Called on the calling thread for every primitive polynomial, in ascending order.
+     * @param on_progress Optional; called on the calling thread at most every `progress_interval_ms`, and once at the end.
+     * @return The number of primitive polynomials found.
+     * @throws std::invalid_argument If the degree is outside 1 to 63 or the chunk size is 0.
+     */
+    static uint64 enumerate(const PrimitiveSearchOptions& options, ThreadPool& pool,
+                            const ResultCallback& on_result, const ProgressCallback& on_progress = {});
+
+private:
+    /**
+     * @brief Applies the cheap rejection filters to a packed candidate.
+     * @param bits The candidate, bit i being the coefficient of x^i.
+     * @param options The search options, for the degree and weight filter.
+     * @return False if the candidate cannot be primitive, true if it needs the full test.
+     */
+    static bool passesFilters(uint64 bits, const PrimitiveSearchOptions& options);
+
+    /**
+     * @brief Reduces a packed polynomial modulo a small packed polynomial.
+     * @param bits The dividend.
+     * @param divisor The divisor. Must be non-zero.
+     * @return The remainder.
+     */
+    static uint64 reduceWord(uint64 bits, uint64 divisor);
+};
+
+#endif //CRYPTOGRAPHY1_PRIMITIVEPOLYNOMIALSEARCH_H
@@ -0,0 +1,118 @@
+#ifndef CRYPTOGRAPHY1_STREAMINGKASISKI_H
+#define CRYPTOGRAPHY1_STREAMINGKASISKI_H
+
+#include "Types.h"
+#include "Kasiski.h"
+#include <istream>
+
+/**
+ * @class StreamingKasiski
+ * @brief Kasiski examination over a ciphertext that arrives in chunks and is never held in memory.
+ * @details A Rabin-Karp hash rolls over every window of `window_length` characters. A direct-mapped table
+ *          remembers where each window hash was last seen; when a window's hash is already in the table,
+ *          the spacing to its previous occurrence is counted. The table has a fixed size, so a repeat whose
+ *          previous occurrence has been evicted by a colliding window is missed, which only thins out the
+ *          statistics. Hash collisions can likewise add a stray spacing, which the factor histogram absorbs.
+ *
+ *          Spacings below `distance_buckets` are tallied by value and only turned into factor counts when
+ *          the histogram is read, so the per-character cost is a multiply, a table probe and an increment.
+ *          Characters are compared as raw bytes and positions continue across chunk boundaries.
+ */
+class StreamingKasiski {
+public:
+    /**
+     * @brief The default table size, as a power of two.
+     * @details 2^16 entries of 16 bytes fit in the L2 cache of most machines.
+     */
+    static constexpr uint32 default_table_bits = 16;
+
+    /**
+     * @brief Spacings below this value are tallied exactly and factored lazily.
+     */
+    static constexpr uint32 distance_buckets = 1 << 16;
+
+    /**
+     * @brief Creates an empty examination.
+     * @param window_length The length of the repeats to look for. Must be positive.
+     * @param table_bits The table holds 2^table_bits window hashes. Must be between 1 and 30.
+     * @param max_factor The largest spacing factor counted in the histogram.
+     * @throws std::invalid_argument If a parameter is out of range.
+     */
+    explicit StreamingKasiski(uint32 window_length, uint32 table_bits = default_table_bits,
+                              uint32 max_factor = Kasiski::default_max_factor);
+
+    /**
+     * @brief Feeds the next chunk of ciphertext.
+     * @param data The chunk.
+     * @param size The number of characters in the chunk.
+     */
+    void update(const char* data, datatype_size size);
+
+    /**
+     * @brief Feeds the next chunk of ciphertext.
+     * @param chunk The chunk.
+     */
+    void update(const String& chunk);
+
+    /**
+     * @brief Feeds everything that is left in a stream, one chunk at a time.
+     * @param input The stream to read until end of file.
+     * @param chunk_size The number of characters read at once.
+     * @return The number of characters read.
+     */
+    uint64 update(std::istream& input, datatype_size chunk_size = 1 << 16);
+
+    /**
+     * @brief Computes the factor histogram of all spacings seen so far.
+     * @return histogram[f] counts the spacings divisible by f, for f up to `max_factor`.
+     */
+    Vector(uint64) getFactorHistogram() const;
+
+    /**
+     * @brief Estimates the key length from the spacings seen so far.
+     * @return The estimate, see `Kasiski::estimateKeyLength`, or 0 if no window has repeated yet.
+     */
+    uint32 estimateKeyLength() const;
+
+    /**
+     * @brief Gets the number of characters consumed so far.
+     * @return The position in the stream.
+     */
+    uint64 getPosition() const;
+
+    /**
+     * @brief Gets the number of repeated windows found so far.
+     * @return The number of spacings counted.
+     */
+    uint64 getRepeatCount() const;
+
+    /**
+     * @brief Forgets everything seen so far, keeping the parameters.
+     */
+    void reset();
+
+private:
+    /**
+     * @brief A table slot: a window hash and the position just past that window, 0 if the slot is empty.
+     */
+    struct Entry {
+        uint64 hash;
+        uint64 end;
+    };
+
+    uint32 window_length;
+    uint32 table_bits;
+    uint32 max_factor;
+    uint64 base_power;           ///< base^window_length, to roll the oldest character out.
+
+    Vector(Entry) table;
+    Vector(uint8) recent;        ///< The last `window_length` characters, as a ring buffer.
+    uint32 recent_index;
+    uint64 hash;
+    uint64 position;
+    uint64 repeat_count;
+    Vector(uint64) distance_counts; ///< distance_counts[d] counts the spacings d below `distance_buckets`.
+    Vector(uint64) far_factors;     ///< Factor counts of the spacings from `distance_buckets` up.
+};
+
+#endif //CRYPTOGRAPHY1_STREAMINGKASISKI_H
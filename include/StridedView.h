@@ -0,0 +1,189 @@
+#ifndef CRYPTOGRAPHY1_STRIDEDVIEW_H
+#define CRYPTOGRAPHY1_STRIDEDVIEW_H
+
+#include "Types.h"
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+/**
+ * @class StridedView
+ * @brief A read-only view of every `stride`-th character of a buffer, starting at some offset.
+ * @details Column c of a Vigenère ciphertext with key length k is the view with offset c and stride k, and a
+ *          stride of 1 is an ordinary substring. The view refers to the original characters, so building one
+ *          neither allocates nor copies, and the buffer must outlive it.
+ */
+class StridedView {
+public:
+    /**
+     * @class Iterator
+     * @brief A random-access iterator over the characters of a view.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char*;
+        using reference = const char&;
+
+        Iterator() = default;
+
+        Iterator(const char* first, datatype_size stride, datatype_size index)
+            : first(first), stride(stride), index(index) {
+        }
+
+        reference operator*() const {
+            return first[index * stride];
+        }
+
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        Iterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++index;
+            return previous;
+        }
+
+        Iterator& operator--() {
+            --index;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator previous = *this;
+            --index;
+            return previous;
+        }
+
+        Iterator& operator+=(difference_type n) {
+            index += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n) {
+            index -= n;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n) {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it) {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n) {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator& a, const Iterator& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.index == b.index;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return a.index != b.index;
+        }
+
+        friend bool operator<(const Iterator& a, const Iterator& b) {
+            return a.index < b.index;
+        }
+
+        friend bool operator>(const Iterator& a, const Iterator& b) {
+            return a.index > b.index;
+        }
+
+        friend bool operator<=(const Iterator& a, const Iterator& b) {
+            return a.index <= b.index;
+        }
+
+        friend bool operator>=(const Iterator& a, const Iterator& b) {
+            return a.index >= b.index;
+        }
+
+    private:
+        // Positions are kept as indices so that the end iterator never forms a pointer past the buffer.
+        const char* first = nullptr;
+        datatype_size stride = 1;
+        datatype_size index = 0;
+    };
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    StridedView() = default;
+
+    /**
+     * @brief Creates a view of `text[offset]`, `text[offset + stride]`, ... up to the end of `text`.
+     * @param text The underlying characters.
+     * @param offset The position of the first character. An offset at or past the end gives an empty view.
+     * @param stride The distance between consecutive characters. Must be positive.
+     */
+    explicit StridedView(std::string_view text, datatype_size offset = 0, datatype_size stride = 1)
+        : first(text.data() + (offset < text.size() ? offset : text.size())),
+          count(offset < text.size() ? (text.size() - offset + stride - 1) / stride : 0),
+          stride(stride) {
+    }
+
+    /**
+     * @brief Gets the number of characters in the view.
+     */
+    datatype_size size() const {
+        return count;
+    }
+
+    /**
+     * @brief Reports whether the view has no characters.
+     */
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * @brief Gets the distance between consecutive characters in the underlying buffer.
+     */
+    datatype_size getStride() const {
+        return stride;
+    }
+
+    /**
+     * @brief Gets the i-th character of the view. `i` must be less than `size()`.
+     */
+    char operator[](datatype_size i) const {
+        return first[i * stride];
+    }
+
+    Iterator begin() const {
+        return Iterator(first, stride, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(first, stride, count);
+    }
+
+    /**
+     * @brief Copies the characters into a string.
+     */
+    String toString() const {
+        return String(begin(), end());
+    }
+
+private:
+    const char* first = nullptr;
+    datatype_size count = 0;
+    datatype_size stride = 1;
+};
+
+#endif //CRYPTOGRAPHY1_STRIDEDVIEW_H
@@ -0,0 +1,94 @@
+#ifndef CRYPTOGRAPHY1_THREADPOOL_H
+#define CRYPTOGRAPHY1_THREADPOOL_H
+
+#include "Types.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class ThreadPool
+ * @brief A fixed-size pool of worker threads with per-worker task queues and work stealing.
+ *
+ * Every worker owns a deque. Tasks submitted from outside the pool are dealt round-robin over the
+ * deques, and tasks submitted from inside a task go to the current worker's own deque. A worker takes
+ * its newest task first and, once its deque is empty, steals the oldest task from another worker, so
+ * uneven tasks balance out without a single shared queue becoming the bottleneck.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param thread_count The number of workers. 0 uses one worker per hardware thread.
+     */
+    explicit ThreadPool(uint32 thread_count = 0);
+
+    /**
+     * @brief Finishes every queued task and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task for execution.
+     * @param task The task to run. Exceptions it throws are kept and rethrown by `wait`.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task has finished.
+     * @details Must not be called from inside a task of the same pool.
+     * @throws Rethrows the first exception thrown by a task since the previous `wait`.
+     */
+    void wait();
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return The number of workers.
+     */
+    uint32 getThreadCount() const;
+
+private:
+    /**
+     * @brief The task deque owned by one worker.
+     */
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /**
+     * @brief The main loop of a worker thread.
+     * @param index The index of the worker.
+     */
+    void run(uint32 index);
+
+    /**
+     * @brief Takes a task from the worker's own deque, or steals one from another worker.
+     * @param index The index of the worker looking for work.
+     * @param task Receives the task.
+     * @return True if a task was found, false if every deque was empty.
+     */
+    bool tryTakeTask(uint32 index, std::function<void()>& task);
+
+    Vector(std::unique_ptr<WorkerQueue>) queues;
+    Vector(std::thread) threads;
+
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    std::atomic<int64> queued_tasks{0};    ///< Tasks sitting in a deque.
+    std::atomic<uint64> pending_tasks{0};  ///< Tasks submitted but not finished.
+    std::atomic<uint32> next_queue{0};
+    bool stopping = false;
+    std::exception_ptr first_error;
+};
+
+#endif //CRYPTOGRAPHY1_THREADPOOL_H
@@ -2,6 +2,7 @@
 #define CRYPTOGRAPHY1_UTILS_H
 
 #include "Types.h"
+#include "StridedView.h"
 
 /**
  * @class Utils
@@ -58,6 +59,52 @@ public:
      */
     static char convertIntToChar(uint8 i, const String& charset = "abcdefghijklmnopqrstuvwxyz");
 
+    /**
+     * @brief The number of letters in the English alphabet.
+     */
+    static constexpr uint8 english_alphabet_size = 26;
+
+    /**
+     * @brief Converts a buffer of characters to English letter indices.
+     *
+     * Letters of either case map to 0-25 and every other byte maps to `english_alphabet_size`, so the output
+     * has one entry per input character and positions are preserved. The conversion is branchless and
+     * vectorizes.
+     *
+     * @param text The characters to convert.
+     * @param size The number of characters.
+     * @param out The destination, `size` entries. May alias `text`.
+     */
+    static void convertLettersToIndices(const char* text, datatype_size size, uint8* out);
+
+    /**
+     * @brief Counts the English letters of a text.
+     *
+     * Reads the characters in place, so a column of a ciphertext can be counted without copying it out.
+     *
+     * @param text The characters to count.
+     * @param counts Receives the number of occurrences of each letter index 0-25, case-insensitively, and at
+     *               index `english_alphabet_size` the number of other characters. Must hold 27 zeroed entries.
+     */
+    static void countLetters(const StridedView& text, uint32* counts);
+
+    /**
+     * @brief The number of letters in the Greek alphabet.
+     */
+    static constexpr uint8 greek_alphabet_size = 24;
+
+    /**
+     * @brief Converts a buffer of Greek characters to letter indices.
+     *
+     * Letters map to 0-23 in the order of `convertGreekCharToInt`, with final sigma folded into sigma, and
+     * every other character maps to `greek_alphabet_size`.
+     *
+     * @param text The characters to convert.
+     * @param size The number of characters.
+     * @param out The destination, `size` entries.
+     */
+    static void convertGreekLettersToIndices(const wide_char* text, datatype_size size, uint8* out);
+
     /**
      * @brief Returns the digits of an unsigned integer as a vector of unsigned integers.
      *
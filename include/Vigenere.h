@@ -0,0 +1,88 @@
+#ifndef CRYPTOGRAPHY1_VIGENERE_H
+#define CRYPTOGRAPHY1_VIGENERE_H
+
+#include "Types.h"
+
+/**
+ * @class Vigenere
+ * @brief Bulk Vigenère encryption and decryption with a key prepared once.
+ * @details The key is turned into per-position letter offsets, repeated so that any `block_size` consecutive
+ *          offsets can be loaded from one place. Each letter of the text is then lowercased, offset and
+ *          reduced modulo 26 with a compare-free unsigned minimum, and non-letters are blended back
+ *          unchanged. The kernel processes 32 bytes per step with AVX2 when the CPU reports it at runtime,
+ *          16 bytes with SSE2 on other x86-64 CPUs, and one byte at a time elsewhere.
+ *
+ *          The output matches `Crypto::vigenereDecipher`: letters come out lowercase, every other byte is
+ *          copied, the key advances on every position, and a key character that is not a letter acts as a
+ *          shift of -1.
+ */
+class Vigenere {
+public:
+    /**
+     * @brief The number of bytes the widest kernel processes per step.
+     */
+    static constexpr uint32 block_size = 32;
+
+    /**
+     * @brief Prepares a key.
+     * @param key The key. Letters of either case give shifts 0-25.
+     * @throws std::invalid_argument If the key is empty.
+     */
+    explicit Vigenere(const String& key);
+
+    /**
+     * @brief Prepares a key given as shifts.
+     * @param shifts The shift of every key position, 0-25.
+     * @param key_length The number of shifts. Must be positive.
+     * @throws std::invalid_argument If the key is empty or a shift is out of range.
+     */
+    Vigenere(const uint8* shifts, uint32 key_length);
+
+    /**
+     * @brief Gets the key length.
+     */
+    uint32 getKeyLength() const;
+
+    /**
+     * @brief Encrypts a buffer.
+     * @param input The plaintext.
+     * @param size The number of bytes.
+     * @param output The destination, `size` bytes. May be `input` itself but must not overlap it otherwise.
+     * @param position The position of `input[0]` in the whole message, which selects the key letter.
+     */
+    void encipher(const char* input, datatype_size size, char* output, uint64 position = 0) const;
+
+    /**
+     * @brief Decrypts a buffer.
+     * @see encipher
+     */
+    void decipher(const char* input, datatype_size size, char* output, uint64 position = 0) const;
+
+    /**
+     * @brief Reports whether the AVX2 kernel is being used.
+     * @return True if the CPU supports AVX2, false for the SSE2 or scalar kernel.
+     */
+    static bool hasAvx2Support();
+
+private:
+    /**
+     * @brief Signature shared by the kernels: adds offsets[(position + i) % key_length] to every letter.
+     */
+    using Kernel = void (*)(const char*, datatype_size, const uint8*, uint32, uint32, char*);
+
+    /**
+     * @brief Picks the kernel for this CPU. Evaluated once.
+     */
+    static Kernel selectKernel();
+
+    /**
+     * @brief Repeats per-position offsets so that `block_size` of them can be read from any start.
+     */
+    static Vector(uint8) repeatOffsets(const Vector(uint8)& offsets);
+
+    uint32 key_length;
+    Vector(uint8) encipher_offsets; ///< The shift of every key position, repeated.
+    Vector(uint8) decipher_offsets; ///< 26 minus the shift, repeated, so decryption is also an addition.
+};
+
+#endif //CRYPTOGRAPHY1_VIGENERE_H
@@ -1,11 +1,20 @@
 #include <cmath>
 #include <iostream>
 #include "Polynomial.h"
+#include "GF2Polynomial.h"
+#include "PrimitivePolynomialSearch.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 #include "Logger.h"
 #include <ostream>
 #include <ctime>
 #include "Crypto.h"
+#include "AesContext.h"
+#include "AvalancheAnalysis.h"
+#include "BatchCracker.h"
+#include <fstream>
+#include <cstring>
+#include <memory>
 
 void exercise1() {
     wide_char initial_message[24] = {L'ο',L'κ',L'η',L'θ',L'μ',L'φ',L'δ',L'ζ',L'θ',L'γ',L'ο',L'θ',
@@ -130,23 +139,17 @@ void exercise5() {
 }
 
 void exercise6() {
-    uint8 count = 0;
     constexpr uint8 degree = 5;
 
+    ThreadPool pool;
+    PrimitiveSearchOptions options;
+    options.degree = degree;
+
     Logger::instance().log("Primitive polynomials:");
-    // 111111 = 63
-    uint8 max_coefficient = 63;
-    // 100000 = 32
-    uint8 min_coefficient = 32;
-    for (int32 i = min_coefficient; i < max_coefficient + 1; i++) {
-        Vector(int32) coefficients = Utils::intToBits(i);
-        Polynomial gf2_polynomial = Polynomial(degree, coefficients);
-        if (gf2_polynomial.gf2IsPrimitive()) {
-            Logger::instance().log(gf2_polynomial.toString());
-            count++;
-        }
-    }
-    Logger::instance().log("Found %i Primitive polynomials", count);
+    const uint64 count = PrimitivePolynomialSearch::enumerate(options, pool, [](const GF2Polynomial& polynomial) {
+        Logger::instance().log(polynomial.toString());
+    });
+    Logger::instance().log("Found %i Primitive polynomials", static_cast<int32>(count));
 }
 
 void exercise9() {
@@ -159,18 +162,21 @@ void exercise9() {
     const String iv = Utils::generateRandomString(16, charset);
     int32 dif_ecb = 0;
     int32 dif_cbc = 0;
+    // The key is expanded once; every message restarts from the same IV.
+    AesContext ecb(AesMode::ECB, key);
+    AesContext cbc(AesMode::CBC, key, iv);
     for (int32 i = 0; i < iterations; i++) {
         // Generating a random message using generateOTP function.
         String msg1 = Utils::generateRandomString(length, charset);
         String msg2 = msg1;
         msg2[0] ^= 1;
 
-        String cipher1 = Crypto::encryptECB(key, msg1);
-        String cipher2 = Crypto::encryptECB(key, msg2);
+        String cipher1 = ecb.process(msg1);
+        String cipher2 = ecb.process(msg2);
         dif_ecb += Crypto::countDiffBits(cipher1, cipher2);
 
-        cipher1 = Crypto::encryptCBC(key, iv, msg1);
-        cipher2 = Crypto::encryptCBC(key, iv, msg2);
+        cipher1 = cbc.process(msg1);
+        cipher2 = cbc.process(msg2);
         dif_cbc += Crypto::countDiffBits(cipher1, cipher2);
 
     }
@@ -183,11 +189,102 @@ void exercise9() {
 
     Logger::instance().log("ECB avg diff bits: %f, Percentage: %f", avg_ecb, ecb_pct);
     Logger::instance().log("CBC avg diff bits: %f, Percentage: %f", avg_cbc, cbc_pct);
+
+    // The same statistic over every bit of one block, with the full strict avalanche criterion matrix.
+    ThreadPool pool;
+    AvalancheOptions options;
+    options.trials = 2000;
+    const AvalancheReport report = AvalancheAnalysis::run([&key]() -> AvalancheAnalysis::Cipher {
+        auto block = std::make_shared<AesContext>(AesMode::ECB, key);
+        block->setPadding(false);
+        return [block](const uint8* input, uint8* output) {
+            block->process(input, AesContext::block_size, output);
+        };
+    }, AesContext::block_size, AesContext::block_size, pool, options);
+    const ConfidenceInterval fraction = report.getMeanFlipFraction();
+    Logger::instance().log("AES block avalanche over %llu pairs: %f%% of bits flip (95%% CI %f-%f)",
+                           report.getPairs(), fraction.estimate * 100.0, fraction.lower * 100.0,
+                           fraction.upper * 100.0);
+    Logger::instance().log("SAC matrix: max bias %f, %llu of %u entries outside their 95%% CI",
+                           report.getMaxSacBias(), report.countSacViolations(),
+                           report.input_bits * report.output_bits);
 }
 
-int main() {
+/**
+ * @brief Escapes a batch output field so it cannot break its record: backslash, tab, line feed and carriage
+ *        return become `\\`, `\t`, `\n` and `\r`.
+ * @param field The raw field.
+ * @return The escaped field.
+ */
+String escapeField(const String& field) {
+    String escaped;
+    escaped.reserve(field.size());
+    for (const char c : field) {
+        switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '\t': escaped += "\\t"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            default: escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Cracks a batch of Vigenère ciphertexts and writes one tab-separated line per result.
+ * @details Text fields are escaped with `escapeField`, so a multi-line ciphertext file stays on one line.
+ * @param input A directory of ciphertext files or a file with one ciphertext per line.
+ * @param output The file to write results to, or nullptr for the standard output.
+ * @return The process exit code.
+ */
+int runBatch(const char* input, const char* output) {
+    std::ofstream output_file;
+    if (output != nullptr) {
+        output_file.open(output);
+        if (!output_file) {
+            Logger::instance().log("Failed to open %s", output);
+            return 1;
+        }
+    }
+    std::ostream& results = output != nullptr ? output_file : std::cout;
+
+    ThreadPool pool;
+    BatchCracker cracker(pool);
+    BatchStats stats;
+    try {
+        stats = cracker.runPath(input, [&results](const CrackResult& result) {
+            results << escapeField(result.name) << '\t' << result.key_length << '\t' << escapeField(result.key)
+                    << '\t' << static_cast<uint64>(result.seconds * 1e6) << '\t'
+                    << (result.error.empty() ? escapeField(result.plaintext) : "error: " + escapeField(result.error))
+                    << '\n';
+        });
+    } catch (const std::exception& error) {
+        Logger::instance().log("Batch failed: %s", error.what());
+        return 1;
+    }
+    results.flush();
+
+    Logger::instance().log("Cracked %llu ciphertexts (%llu failed, %llu bytes) in %.3f s on %u threads",
+                           stats.jobs, stats.failed, stats.bytes, stats.wall_seconds, pool.getThreadCount());
+    Logger::instance().log("Throughput: %.1f jobs/s, %.2f MB/s; mean job %.3f ms, slowest %.3f ms",
+                           stats.getJobsPerSecond(), stats.getBytesPerSecond() / 1e6,
+                           stats.jobs > 0 ? stats.busy_seconds / stats.jobs * 1e3 : 0.0,
+                           stats.max_job_seconds * 1e3);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     std::setlocale(LC_ALL, "en_US.UTF-8");
 
+    if (argc >= 2 && std::strcmp(argv[1], "--batch") == 0) {
+        if (argc < 3 || argc > 4) {
+            Logger::instance().log("Usage: %s --batch <directory or file> [output file]", argv[0]);
+            return 2;
+        }
+        return runBatch(argv[2], argc == 4 ? argv[3] : nullptr);
+    }
+
     Logger::instance().print_separator();
     Logger::instance().log("Exercise 1:");
     Logger::instance().print_separator();
@@ -0,0 +1,192 @@
+#include "AeadContext.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+#include <openssl/evp.h>
+
+namespace {
+
+const EVP_CIPHER* selectCipher(AeadAlgorithm algorithm) {
+    switch (algorithm) {
+        case AeadAlgorithm::AES_128_GCM: return EVP_aes_128_gcm();
+        case AeadAlgorithm::CHACHA20_POLY1305: return EVP_chacha20_poly1305();
+    }
+    throw std::invalid_argument("Unknown AEAD algorithm");
+}
+
+/**
+ * @brief Feeds data through EVP_CipherUpdate, which takes int lengths, in pieces. A null output feeds AAD.
+ */
+datatype_size cipherUpdate(EVP_CIPHER_CTX* context, uint8* output, const uint8* input, datatype_size size) {
+    constexpr datatype_size max_piece = INT_MAX / 16 * 16;
+    datatype_size written = 0;
+    int len;
+    for (datatype_size offset = 0; offset < size; offset += max_piece) {
+        const datatype_size piece = std::min(size - offset, max_piece);
+        if (1 != EVP_CipherUpdate(context, output == nullptr ? nullptr : output + written, &len, input + offset,
+                                  static_cast<int>(piece))) {
+            throw std::runtime_error("Failed to update cipher");
+        }
+        written += len;
+    }
+    return written;
+}
+
+void deriveBatchNonce(const uint8* base_nonce, uint64 index, uint8* nonce) {
+    std::copy(base_nonce, base_nonce + AeadContext::nonce_size, nonce);
+    for (datatype_size i = AeadContext::nonce_size; index != 0; index >>= 8) {
+        nonce[--i] ^= static_cast<uint8>(index & 0xff);
+    }
+}
+
+std::span<const uint8> bytes(const String& text) {
+    return {reinterpret_cast<const uint8*>(text.data()), text.size()};
+}
+
+} // namespace
+
+datatype_size AeadBatch::size() const {
+    return offsets.empty() ? 0 : offsets.size() - 1;
+}
+
+std::span<const uint8> AeadBatch::getMessage(datatype_size index) const {
+    return {arena.data() + offsets[index], offsets[index + 1] - offsets[index]};
+}
+
+void AeadContext::ContextDeleter::operator()(EVP_CIPHER_CTX* context) const {
+    EVP_CIPHER_CTX_free(context);
+}
+
+AeadContext::AeadContext(AeadAlgorithm algorithm, const String& key) : algorithm(algorithm) {
+    if (key.length() != getKeySize(algorithm)) {
+        throw std::length_error(algorithm == AeadAlgorithm::AES_128_GCM
+                                ? "Key must be 16 bytes for AES-128-GCM."
+                                : "Key must be 32 bytes for ChaCha20-Poly1305.");
+    }
+
+    context.reset(EVP_CIPHER_CTX_new());
+    if (!context) {
+        throw std::runtime_error("Failed to create new EVP_CIPHER_CTX");
+    }
+    // Both ciphers default to a 12-byte nonce, so the nonce length never has to be set.
+    if (1 != EVP_CipherInit_ex(context.get(), selectCipher(algorithm), nullptr,
+                               reinterpret_cast<const unsigned char*>(key.data()), nullptr, 1)) {
+        throw std::runtime_error("Failed to initialize cipher");
+    }
+}
+
+AeadContext::~AeadContext() = default;
+
+AeadContext::AeadContext(AeadContext&& other) noexcept = default;
+
+AeadContext& AeadContext::operator=(AeadContext&& other) noexcept = default;
+
+AeadAlgorithm AeadContext::getAlgorithm() const {
+    return algorithm;
+}
+
+datatype_size AeadContext::getKeySize(AeadAlgorithm algorithm) {
+    return algorithm == AeadAlgorithm::AES_128_GCM ? 16 : 32;
+}
+
+void AeadContext::start(std::span<const uint8> nonce, std::span<const uint8> aad, bool encrypt) {
+    if (nonce.size() != nonce_size) {
+        throw std::length_error("Nonce must be 12 bytes.");
+    }
+    // Passing no cipher and no key keeps the key and only restarts the context with the new nonce.
+    if (1 != EVP_CipherInit_ex(context.get(), nullptr, nullptr, nullptr, nonce.data(), encrypt ? 1 : 0)) {
+        throw std::runtime_error("Failed to initialize cipher");
+    }
+    cipherUpdate(context.get(), nullptr, aad.data(), aad.size());
+}
+
+datatype_size AeadContext::seal(std::span<const uint8> nonce, std::span<const uint8> aad,
+                                std::span<const uint8> plaintext, std::span<uint8> output) {
+    if (output.size() < plaintext.size() + tag_size) {
+        throw std::invalid_argument("Output buffer is too small");
+    }
+    start(nonce, aad, true);
+    datatype_size written = cipherUpdate(context.get(), output.data(), plaintext.data(), plaintext.size());
+    int len;
+    if (1 != EVP_CipherFinal_ex(context.get(), output.data() + written, &len)) {
+        throw std::runtime_error("Failed to finalize encryption");
+    }
+    written += len;
+    if (1 != EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_AEAD_GET_TAG, tag_size, output.data() + written)) {
+        throw std::runtime_error("Failed to get authentication tag");
+    }
+    return written + tag_size;
+}
+
+datatype_size AeadContext::open(std::span<const uint8> nonce, std::span<const uint8> aad,
+                                std::span<const uint8> sealed, std::span<uint8> output) {
+    if (sealed.size() < tag_size) {
+        throw std::length_error("Sealed message is shorter than a tag.");
+    }
+    const datatype_size ciphertext_size = sealed.size() - tag_size;
+    if (output.size() < ciphertext_size) {
+        throw std::invalid_argument("Output buffer is too small");
+    }
+    start(nonce, aad, false);
+    datatype_size written = cipherUpdate(context.get(), output.data(), sealed.data(), ciphertext_size);
+    // The tag is only read by the ctrl call, but OpenSSL declares its argument non-const.
+    Array(uint8, tag_size) tag;
+    std::copy(sealed.begin() + ciphertext_size, sealed.end(), tag.begin());
+    if (1 != EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_AEAD_SET_TAG, tag_size, tag.data())) {
+        throw std::runtime_error("Failed to set authentication tag");
+    }
+    int len;
+    if (1 != EVP_CipherFinal_ex(context.get(), output.data() + written, &len)) {
+        throw std::runtime_error("Authentication failed");
+    }
+    return written + len;
+}
+
+String AeadContext::seal(const String& nonce, const String& plaintext, const String& aad) {
+    String sealed(plaintext.size() + tag_size, '\0');
+    seal(bytes(nonce), bytes(aad), bytes(plaintext), {reinterpret_cast<uint8*>(sealed.data()), sealed.size()});
+    return sealed;
+}
+
+String AeadContext::open(const String& nonce, const String& sealed, const String& aad) {
+    if (sealed.size() < tag_size) {
+        throw std::length_error("Sealed message is shorter than a tag.");
+    }
+    String plaintext(sealed.size() - tag_size, '\0');
+    plaintext.resize(open(bytes(nonce), bytes(aad), bytes(sealed),
+                          {reinterpret_cast<uint8*>(plaintext.data()), plaintext.size()}));
+    return plaintext;
+}
+
+AeadBatch AeadContext::sealBatch(const String& base_nonce, const Vector(std::string_view)& messages,
+                                 const String& aad) {
+    if (base_nonce.size() != nonce_size) {
+        throw std::length_error("Nonce must be 12 bytes.");
+    }
+
+    AeadBatch batch;
+    batch.offsets.resize(messages.size() + 1);
+    batch.offsets[0] = 0;
+    for (datatype_size i = 0; i < messages.size(); ++i) {
+        batch.offsets[i + 1] = batch.offsets[i] + messages[i].size() + tag_size;
+    }
+    batch.arena.resize(batch.offsets.back());
+
+    Array(uint8, nonce_size) nonce;
+    for (datatype_size i = 0; i < messages.size(); ++i) {
+        deriveBatchNonce(bytes(base_nonce).data(), i, nonce.data());
+        seal(nonce, bytes(aad), {reinterpret_cast<const uint8*>(messages[i].data()), messages[i].size()},
+             {batch.arena.data() + batch.offsets[i], batch.offsets[i + 1] - batch.offsets[i]});
+    }
+    return batch;
+}
+
+String AeadContext::getBatchNonce(const String& base_nonce, uint64 index) {
+    if (base_nonce.size() != nonce_size) {
+        throw std::length_error("Nonce must be 12 bytes.");
+    }
+    String nonce(nonce_size, '\0');
+    deriveBatchNonce(bytes(base_nonce).data(), index, reinterpret_cast<uint8*>(nonce.data()));
+    return nonce;
+}
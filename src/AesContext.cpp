@@ -0,0 +1,200 @@
+#include "AesContext.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <stdexcept>
+
+#include <openssl/evp.h>
+
+namespace {
+
+const EVP_CIPHER* selectCipher(AesMode mode) {
+    switch (mode) {
+        case AesMode::ECB: return EVP_aes_128_ecb();
+        case AesMode::CBC: return EVP_aes_128_cbc();
+        case AesMode::CTR: return EVP_aes_128_ctr();
+    }
+    throw std::invalid_argument("Unknown AES mode");
+}
+
+} // namespace
+
+void AesContext::ContextDeleter::operator()(EVP_CIPHER_CTX* context) const {
+    EVP_CIPHER_CTX_free(context);
+}
+
+AesContext::AesContext(AesMode mode, const String& key, const String& iv, AesDirection direction)
+    : mode(mode), direction(direction), iv{} {
+    if (key.length() != key_size) {
+        throw std::length_error("Key must be 16 bytes for AES-128.");
+    }
+    if (!iv.empty()) {
+        setIv(iv);
+    }
+
+    context.reset(EVP_CIPHER_CTX_new());
+    if (!context) {
+        throw std::runtime_error("Failed to create new EVP_CIPHER_CTX");
+    }
+    if (1 != EVP_CipherInit_ex(context.get(), selectCipher(mode), nullptr,
+                               reinterpret_cast<const unsigned char*>(key.data()), this->iv.data(),
+                               direction == AesDirection::Encrypt ? 1 : 0)) {
+        throw std::runtime_error("Failed to initialize cipher");
+    }
+}
+
+AesContext::~AesContext() = default;
+
+AesContext::AesContext(AesContext&& other) noexcept = default;
+
+AesContext& AesContext::operator=(AesContext&& other) noexcept = default;
+
+AesMode AesContext::getMode() const {
+    return mode;
+}
+
+AesDirection AesContext::getDirection() const {
+    return direction;
+}
+
+void AesContext::setIv(const String& iv) {
+    if (iv.length() != block_size) {
+        throw std::length_error("IV must be 16 bytes for AES-128.");
+    }
+    std::copy(iv.begin(), iv.end(), this->iv.begin());
+}
+
+void AesContext::setPadding(bool enabled) {
+    EVP_CIPHER_CTX_set_padding(context.get(), enabled ? 1 : 0);
+    padding = enabled;
+}
+
+datatype_size AesContext::getCiphertextSize(datatype_size size) {
+    return (size / block_size + 1) * block_size;
+}
+
+datatype_size AesContext::getOutputBound(datatype_size size) const {
+    return mode == AesMode::CTR || !padding ? size : size + block_size;
+}
+
+void AesContext::reset() {
+    // Passing no cipher and no key keeps the expanded key and only resets the padding and chaining state.
+    if (1 != EVP_CipherInit_ex(context.get(), nullptr, nullptr, nullptr, mode == AesMode::ECB ? nullptr : iv.data(),
+                               -1)) {
+        throw std::runtime_error("Failed to initialize cipher");
+    }
+}
+
+datatype_size AesContext::update(std::span<const uint8> input, std::span<uint8> output) {
+    if (output.size() < getOutputBound(input.size())) {
+        throw std::invalid_argument("Output buffer is too small");
+    }
+
+    datatype_size written = 0;
+    int len;
+    // EVP takes int lengths, so very large chunks go through in whole-block pieces.
+    constexpr datatype_size max_piece = INT_MAX / block_size * block_size;
+    for (datatype_size offset = 0; offset < input.size(); offset += max_piece) {
+        const datatype_size piece = std::min(input.size() - offset, max_piece);
+        if (1 != EVP_CipherUpdate(context.get(), output.data() + written, &len, input.data() + offset,
+                                  static_cast<int>(piece))) {
+            throw std::runtime_error("Failed to update cipher");
+        }
+        written += len;
+    }
+    return written;
+}
+
+datatype_size AesContext::finalize(std::span<uint8> output) {
+    if (output.size() < getOutputBound(0)) {
+        throw std::invalid_argument("Output buffer is too small");
+    }
+    int len;
+    if (1 != EVP_CipherFinal_ex(context.get(), output.data(), &len)) {
+        throw std::runtime_error(direction == AesDirection::Decrypt && mode != AesMode::CTR && padding
+                                 ? "Failed to finalize decryption: bad padding"
+                                 : "Failed to finalize cipher");
+    }
+    return len;
+}
+
+datatype_size AesContext::process(const uint8* input, datatype_size size, uint8* output) {
+    const datatype_size bound = getOutputBound(size);
+    reset();
+    const datatype_size written = update({input, size}, {output, bound});
+    return written + finalize({output + written, bound - written});
+}
+
+String AesContext::process(const String& input) {
+    String output(getOutputBound(input.size()), '\0');
+    const datatype_size written = process(reinterpret_cast<const uint8*>(input.data()), input.size(),
+                                          reinterpret_cast<uint8*>(output.data()));
+    output.resize(written);
+    return output;
+}
+
+uint64 AesContext::processFile(const String& input_path, const String& output_path, datatype_size buffer_size) {
+    if (buffer_size == 0) {
+        throw std::invalid_argument("Buffer size must be positive");
+    }
+    std::ifstream input(input_path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Failed to open " + input_path);
+    }
+    std::ofstream output(output_path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        throw std::runtime_error("Failed to open " + output_path);
+    }
+
+    Array(Vector(uint8), 2) input_buffers = {Vector(uint8)(buffer_size), Vector(uint8)(buffer_size)};
+    Array(Vector(uint8), 2) output_buffers = {Vector(uint8)(getOutputBound(buffer_size)),
+                                               Vector(uint8)(getOutputBound(buffer_size))};
+    auto read = [&input, &input_path](Vector(uint8)& buffer) -> datatype_size {
+        input.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (input.bad()) {
+            throw std::runtime_error("Failed to read " + input_path);
+        }
+        return static_cast<datatype_size>(input.gcount());
+    };
+    auto write = [&output, &output_path](const Vector(uint8)& buffer, datatype_size size) {
+        output.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(size));
+        if (!output) {
+            throw std::runtime_error("Failed to write " + output_path);
+        }
+    };
+
+    // Chunk i is processed from input_buffers[i % 2] into output_buffers[i % 2] while chunk i + 1 is read into
+    // the other input buffer and chunk i - 1 is written from the other output buffer. The futures are
+    // declared after the buffers and streams, so an exception waits for the I/O in flight before those go away.
+    reset();
+    uint64 written = 0;
+    datatype_size current = 0;
+    datatype_size size = read(input_buffers[current]);
+    std::future<void> pending_write;
+    while (size > 0) {
+        std::future<datatype_size> next_read =
+            std::async(std::launch::async, read, std::ref(input_buffers[current ^ 1]));
+        const datatype_size produced = update({input_buffers[current].data(), size}, output_buffers[current]);
+        if (pending_write.valid()) {
+            pending_write.get();
+        }
+        pending_write = std::async(std::launch::async, write, std::cref(output_buffers[current]), produced);
+        written += produced;
+        size = next_read.get();
+        current ^= 1;
+    }
+
+    // output_buffers[current] was written two chunks ago, so the last block can go there.
+    const datatype_size produced = finalize(output_buffers[current]);
+    if (pending_write.valid()) {
+        pending_write.get();
+    }
+    write(output_buffers[current], produced);
+    output.flush();
+    if (!output) {
+        throw std::runtime_error("Failed to write " + output_path);
+    }
+    return written + produced;
+}
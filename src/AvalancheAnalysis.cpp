@@ -0,0 +1,169 @@
+#include "AvalancheAnalysis.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Packs the XOR of two byte strings into 64-bit words; bit j of the result is bit j % 8 of byte j / 8.
+ */
+void packDifference(const uint8* a, const uint8* b, datatype_size size, uint64* words) {
+    for (datatype_size word = 0; word * 8 < size; ++word) {
+        uint64 bits = 0;
+        const datatype_size end = std::min(size, word * 8 + 8);
+        for (datatype_size byte = word * 8; byte < end; ++byte) {
+            bits |= static_cast<uint64>(a[byte] ^ b[byte]) << (8 * (byte - word * 8));
+        }
+        words[word] = bits;
+    }
+}
+
+ConfidenceInterval wilsonInterval(uint64 successes, uint64 trials, float64 z) {
+    if (trials == 0) {
+        return {0.0, 0.0, 1.0};
+    }
+    const float64 n = static_cast<float64>(trials);
+    const float64 p = successes / n;
+    const float64 z2 = z * z;
+    const float64 denominator = 1.0 + z2 / n;
+    const float64 center = (p + z2 / (2.0 * n)) / denominator;
+    const float64 half_width = z * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denominator;
+    return {p, std::max(0.0, center - half_width), std::min(1.0, center + half_width)};
+}
+
+} // namespace
+
+uint64 AvalancheReport::getPairs() const {
+    return trials * input_bits;
+}
+
+ConfidenceInterval AvalancheReport::getFlipProbability(uint32 input_bit, uint32 output_bit, float64 z) const {
+    return wilsonInterval(flip_counts[static_cast<datatype_size>(input_bit) * output_bits + output_bit], trials, z);
+}
+
+ConfidenceInterval AvalancheReport::getMeanFlipFraction(float64 z) const {
+    float64 pairs = 0.0;
+    float64 sum = 0.0;
+    float64 sum_of_squares = 0.0;
+    for (datatype_size distance = 0; distance < distance_counts.size(); ++distance) {
+        const float64 count = static_cast<float64>(distance_counts[distance]);
+        pairs += count;
+        sum += count * distance;
+        sum_of_squares += count * distance * distance;
+    }
+    if (pairs == 0.0 || output_bits == 0) {
+        return {0.0, 0.0, 1.0};
+    }
+    const float64 mean = sum / pairs;
+    const float64 variance = pairs > 1.0 ? std::max(0.0, (sum_of_squares - pairs * mean * mean) / (pairs - 1.0)) : 0.0;
+    const float64 half_width = z * std::sqrt(variance / pairs);
+    return {mean / output_bits, (mean - half_width) / output_bits, (mean + half_width) / output_bits};
+}
+
+float64 AvalancheReport::getMaxSacBias() const {
+    if (trials == 0) {
+        return 0.0;
+    }
+    float64 bias = 0.0;
+    for (uint64 count : flip_counts) {
+        bias = std::max(bias, std::abs(static_cast<float64>(count) / trials - 0.5));
+    }
+    return bias;
+}
+
+uint64 AvalancheReport::countSacViolations(float64 z) const {
+    uint64 violations = 0;
+    for (uint64 count : flip_counts) {
+        const ConfidenceInterval interval = wilsonInterval(count, trials, z);
+        violations += interval.lower > 0.5 || interval.upper < 0.5;
+    }
+    return violations;
+}
+
+AvalancheReport AvalancheAnalysis::run(const CipherFactory& make_cipher, datatype_size input_size,
+                                       datatype_size output_size, ThreadPool& pool, const AvalancheOptions& options) {
+    if (input_size == 0 || output_size == 0) {
+        throw std::invalid_argument("Cipher input and output sizes must be positive");
+    }
+    if (options.batch_size == 0) {
+        throw std::invalid_argument("Batch size must be positive");
+    }
+
+    AvalancheReport report;
+    report.input_bits = static_cast<uint32>(input_size * 8);
+    report.output_bits = static_cast<uint32>(output_size * 8);
+    report.trials = options.trials;
+    const datatype_size matrix_size = static_cast<datatype_size>(report.input_bits) * report.output_bits;
+
+    const uint64 batches = (options.trials + options.batch_size - 1) / options.batch_size;
+    const uint32 workers = static_cast<uint32>(std::clamp<uint64>(batches, 1, pool.getThreadCount()));
+    Vector(Vector(uint64)) worker_flips(workers);
+    Vector(Vector(uint64)) worker_distances(workers);
+
+    for (uint32 worker = 0; worker < workers; ++worker) {
+        pool.submit([&, worker] {
+            const Cipher cipher = make_cipher();
+            Vector(uint64)& flips = worker_flips[worker];
+            Vector(uint64)& distances = worker_distances[worker];
+            flips.assign(matrix_size, 0);
+            distances.assign(report.output_bits + 1, 0);
+
+            Vector(uint8) input(input_size);
+            Vector(uint8) output(output_size);
+            Vector(uint8) flipped_output(output_size);
+            Vector(uint64) difference((output_size + 7) / 8);
+            for (uint64 batch = worker; batch < batches; batch += workers) {
+                std::mt19937_64 generator(options.seed + batch);
+                const uint64 batch_trials = std::min<uint64>(options.batch_size,
+                                                             options.trials - batch * options.batch_size);
+                for (uint64 trial = 0; trial < batch_trials; ++trial) {
+                    for (uint8& byte : input) {
+                        byte = static_cast<uint8>(generator());
+                    }
+                    cipher(input.data(), output.data());
+
+                    for (uint32 input_bit = 0; input_bit < report.input_bits; ++input_bit) {
+                        const uint8 mask = static_cast<uint8>(1u << (input_bit % 8));
+                        input[input_bit / 8] ^= mask;
+                        cipher(input.data(), flipped_output.data());
+                        input[input_bit / 8] ^= mask;
+
+                        packDifference(output.data(), flipped_output.data(), output_size, difference.data());
+                        uint64* row = flips.data() + static_cast<datatype_size>(input_bit) * report.output_bits;
+                        uint32 distance = 0;
+                        for (datatype_size word = 0; word < difference.size(); ++word) {
+                            uint64 bits = difference[word];
+                            distance += std::popcount(bits);
+                            for (; bits != 0; bits &= bits - 1) {
+                                ++row[word * 64 + std::countr_zero(bits)];
+                            }
+                        }
+                        ++distances[distance];
+                    }
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    report.flip_counts.assign(matrix_size, 0);
+    report.distance_counts.assign(report.output_bits + 1, 0);
+    for (uint32 worker = 0; worker < workers; ++worker) {
+        for (datatype_size i = 0; i < matrix_size; ++i) {
+            report.flip_counts[i] += worker_flips[worker][i];
+        }
+        for (datatype_size d = 0; d <= report.output_bits; ++d) {
+            report.distance_counts[d] += worker_distances[worker][d];
+        }
+    }
+    return report;
+}
+
+AvalancheReport AvalancheAnalysis::run(const Cipher& cipher, datatype_size input_size, datatype_size output_size,
+                                       ThreadPool& pool, const AvalancheOptions& options) {
+    return run([&cipher] { return cipher; }, input_size, output_size, pool, options);
+}
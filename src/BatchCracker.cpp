@@ -0,0 +1,168 @@
+#include "BatchCracker.h"
+#include "BoundedQueue.h"
+#include "Crypto.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+float64 secondsSince(Clock::time_point start) {
+    return std::chrono::duration<float64>(Clock::now() - start).count();
+}
+
+} // namespace
+
+float64 BatchStats::getJobsPerSecond() const {
+    return wall_seconds > 0.0 ? jobs / wall_seconds : 0.0;
+}
+
+float64 BatchStats::getBytesPerSecond() const {
+    return wall_seconds > 0.0 ? bytes / wall_seconds : 0.0;
+}
+
+BatchCracker::BatchCracker(ThreadPool& pool, uint32 queue_capacity, uint32 max_key_length)
+    : pool(pool), queue_capacity(queue_capacity), max_key_length(max_key_length) {
+    if (queue_capacity == 0) {
+        throw std::invalid_argument("Queue capacity must be positive");
+    }
+}
+
+CrackResult BatchCracker::crack(const CrackJob& job, uint32 max_key_length) {
+    const Clock::time_point start = Clock::now();
+    CrackResult result{job.id, job.name, 0, "", "", "", 0.0};
+    try {
+        result.key_length = Crypto::findKeyLengthFriedman(job.ciphertext, max_key_length);
+        result.key = Crypto::getKeyWithFrequencyAnalysis(job.ciphertext, result.key_length);
+        result.plaintext = Crypto::vigenereDecipher(job.ciphertext, result.key);
+    } catch (const std::exception& error) {
+        result.error = error.what();
+    }
+    result.seconds = secondsSince(start);
+    return result;
+}
+
+BatchStats BatchCracker::run(const JobSource& source, const ResultSink& sink) {
+    BoundedQueue<CrackJob> queue(queue_capacity);
+    BatchStats stats;
+    std::mutex sink_mutex;
+    std::exception_ptr sink_error;
+    std::atomic<bool> stopped{false};
+
+    const Clock::time_point start = Clock::now();
+    for (uint32 worker = 0; worker < pool.getThreadCount(); ++worker) {
+        pool.submit([&] {
+            CrackJob job;
+            while (!stopped.load(std::memory_order_relaxed) && queue.pop(job)) {
+                const CrackResult result = crack(job, max_key_length);
+
+                std::lock_guard<std::mutex> lock(sink_mutex);
+                ++stats.jobs;
+                stats.failed += !result.error.empty();
+                stats.bytes += job.ciphertext.size();
+                stats.busy_seconds += result.seconds;
+                stats.max_job_seconds = std::max(stats.max_job_seconds, result.seconds);
+                if (stopped) {
+                    continue;
+                }
+                try {
+                    sink(result);
+                } catch (...) {
+                    // Stop the batch: the producer sees a closed queue and the other workers stop taking jobs.
+                    sink_error = std::current_exception();
+                    stopped = true;
+                    queue.close();
+                }
+            }
+        });
+    }
+
+    std::exception_ptr source_error;
+    try {
+        CrackJob job;
+        for (uint64 id = 0; source(job); ++id) {
+            job.id = id;
+            if (!queue.push(std::move(job))) {
+                break;
+            }
+            job = CrackJob();
+        }
+    } catch (...) {
+        source_error = std::current_exception();
+        stopped = true;
+    }
+    queue.close();
+    pool.wait();
+    stats.wall_seconds = secondsSince(start);
+
+    if (source_error) {
+        std::rethrow_exception(source_error);
+    }
+    if (sink_error) {
+        std::rethrow_exception(sink_error);
+    }
+    return stats;
+}
+
+BatchStats BatchCracker::runPath(const String& path, const ResultSink& sink) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+
+    if (fs::is_directory(path, error)) {
+        Vector(fs::path) files;
+        for (const fs::directory_entry& entry : fs::directory_iterator(path, error)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        if (error) {
+            throw std::runtime_error("Failed to list " + path + ": " + error.message());
+        }
+        std::sort(files.begin(), files.end());
+
+        datatype_size next = 0;
+        return run([&](CrackJob& job) {
+            if (next == files.size()) {
+                return false;
+            }
+            const fs::path& file_path = files[next++];
+            std::ifstream file(file_path, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error("Failed to open " + file_path.string());
+            }
+            job.name = file_path.filename().string();
+            job.ciphertext.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            return true;
+        }, sink);
+    }
+
+    std::ifstream input(path);
+    if (!input) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    uint64 line_number = 0;
+    return run([&](CrackJob& job) {
+        String line;
+        while (std::getline(input, line)) {
+            ++line_number;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (!line.empty()) {
+                job.name = "line " + std::to_string(line_number);
+                job.ciphertext = std::move(line);
+                return true;
+            }
+        }
+        return false;
+    }, sink);
+}
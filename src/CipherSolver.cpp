@@ -0,0 +1,338 @@
+#include "CipherSolver.h"
+#include "FrequencyAnalysis.h"
+#include "ThreadPool.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * Keeps a plaintext and its n-gram fitness up to date under changes of a few letters at a time.
+ */
+class IncrementalFitness {
+public:
+    IncrementalFitness(const LanguageModel& model, Vector(uint8) plaintext)
+        : order(model.getMaxOrder()), alphabet_size(model.getAlphabetSize()), table(model.getTable(order)),
+          plaintext(std::move(plaintext)), complete(this->plaintext.size(), 0), fitness(0.0) {
+        // Whether a letter is a letter never changes under decryption, so the scored windows are fixed.
+        uint32 letters_in_row = 0;
+        for (datatype_size end = 0; end < this->plaintext.size(); ++end) {
+            letters_in_row = this->plaintext[end] < alphabet_size ? letters_in_row + 1 : 0;
+            complete[end] = letters_in_row >= order;
+            if (complete[end]) {
+                fitness += windowScore(end);
+            }
+        }
+    }
+
+    float64 getFitness() const {
+        return fitness;
+    }
+
+    const Vector(uint8)& getPlaintext() const {
+        return plaintext;
+    }
+
+    /**
+     * Writes letters[i] at positions[i], which must be ascending, and returns the change in fitness.
+     */
+    float64 change(const Vector(uint32)& positions, const Vector(uint8)& letters) {
+        changed_positions = &positions;
+        previous_letters.resize(positions.size());
+        const float64 before = affectedScore(positions);
+        for (datatype_size i = 0; i < positions.size(); ++i) {
+            previous_letters[i] = plaintext[positions[i]];
+            plaintext[positions[i]] = letters[i];
+        }
+        last_delta = affectedScore(positions) - before;
+        fitness += last_delta;
+        return last_delta;
+    }
+
+    /**
+     * Reverts the last change.
+     */
+    void undo() {
+        const Vector(uint32)& positions = *changed_positions;
+        for (datatype_size i = 0; i < positions.size(); ++i) {
+            plaintext[positions[i]] = previous_letters[i];
+        }
+        fitness -= last_delta;
+    }
+
+private:
+    float64 windowScore(datatype_size end) const {
+        datatype_size index = 0;
+        for (datatype_size i = end + 1 - order; i <= end; ++i) {
+            index = index * alphabet_size + plaintext[i];
+        }
+        return table[index];
+    }
+
+    /**
+     * Sums the windows that contain at least one of the positions, each once.
+     */
+    float64 affectedScore(const Vector(uint32)& positions) const {
+        float64 score = 0.0;
+        datatype_size next_end = 0;
+        for (uint32 position : positions) {
+            const datatype_size last_end = std::min<datatype_size>(position + order - 1, plaintext.size() - 1);
+            for (datatype_size end = std::max<datatype_size>(position, next_end); end <= last_end; ++end) {
+                if (complete[end]) {
+                    score += windowScore(end);
+                }
+            }
+            next_end = std::max(next_end, last_end + 1);
+        }
+        return score;
+    }
+
+    uint32 order;
+    uint32 alphabet_size;
+    const float32* table;
+    Vector(uint8) plaintext;
+    Vector(uint8) complete; ///< complete[e] is set if the window ending at e holds only letters.
+    float64 fitness;
+
+    const Vector(uint32)* changed_positions = nullptr;
+    Vector(uint8) previous_letters;
+    float64 last_delta = 0.0;
+};
+
+/**
+ * Annealing over a key: `propose` makes a random change to the key and the fitness and returns the delta,
+ * `reject` reverts it.
+ */
+template <typename Propose, typename Reject, typename Save>
+void anneal(const SolverOptions& options, std::mt19937_64& generator, float64 start_fitness, Propose propose,
+            Reject reject, Save save) {
+    float64 fitness = start_fitness;
+    float64 best_fitness = start_fitness;
+    save(best_fitness);
+
+    const bool annealing = options.initial_temperature > 0.0 && options.final_temperature > 0.0;
+    float64 temperature = options.initial_temperature;
+    const float64 cooling = annealing && options.iterations > 1
+        ? std::pow(options.final_temperature / options.initial_temperature, 1.0 / (options.iterations - 1))
+        : 1.0;
+    std::uniform_real_distribution<float64> uniform(0.0, 1.0);
+
+    for (uint32 iteration = 0; iteration < options.iterations; ++iteration) {
+        const float64 delta = propose();
+        if (delta > 0.0 || (annealing && uniform(generator) < std::pow(10.0, delta / temperature))) {
+            fitness += delta;
+            if (fitness > best_fitness) {
+                best_fitness = fitness;
+                save(best_fitness);
+            }
+        } else {
+            reject();
+        }
+        temperature *= cooling;
+    }
+}
+
+void checkModel(const LanguageModel& model) {
+    if (model.getMaxOrder() == 0) {
+        throw std::invalid_argument("Language model holds no n-gram table");
+    }
+}
+
+/**
+ * Runs `restarts` searches on the pool and keeps the best, the earliest on ties.
+ */
+template <typename Search>
+SolverResult runSearches(const SolverOptions& options, ThreadPool& pool, Search search) {
+    const uint32 restarts = std::max<uint32>(options.restarts, 1);
+    Vector(SolverResult) results(restarts);
+    for (uint32 restart = 0; restart < restarts; ++restart) {
+        pool.submit([&, restart] {
+            results[restart] = search(restart);
+        });
+    }
+    pool.wait();
+
+    datatype_size best = 0;
+    for (datatype_size restart = 1; restart < restarts; ++restart) {
+        if (results[restart].fitness > results[best].fitness) {
+            best = restart;
+        }
+    }
+    return std::move(results[best]);
+}
+
+} // namespace
+
+SolverResult CipherSolver::solveVigenere(const uint8* indices, datatype_size size, uint32 key_length,
+                                         const LanguageModel& model, ThreadPool& pool,
+                                         const SolverOptions& options) {
+    if (key_length == 0) {
+        throw std::invalid_argument("Key length must be positive");
+    }
+    checkModel(model);
+    const uint32 alphabet_size = model.getAlphabetSize();
+
+    // The letter positions enciphered by each key letter.
+    Vector(Vector(uint32)) column_positions(key_length);
+    for (datatype_size i = 0; i < size; ++i) {
+        if (indices[i] < alphabet_size) {
+            column_positions[i % key_length].push_back(i);
+        }
+    }
+
+    Vector(uint8) start_key = FrequencyAnalysis(model).recoverShifts(indices, size, key_length);
+    for (uint8& shift : start_key) {
+        shift = shift < alphabet_size ? shift : 0;
+    }
+
+    auto decipher = [&](uint32 column, uint8 shift, Vector(uint8)& letters) {
+        const Vector(uint32)& positions = column_positions[column];
+        letters.resize(positions.size());
+        for (datatype_size i = 0; i < positions.size(); ++i) {
+            letters[i] = (indices[positions[i]] + alphabet_size - shift) % alphabet_size;
+        }
+    };
+
+    return runSearches(options, pool, [&](uint32 restart) {
+        std::mt19937_64 generator(options.seed + restart);
+        std::uniform_int_distribution<uint32> random_column(0, key_length - 1);
+        std::uniform_int_distribution<uint32> random_shift(0, alphabet_size - 1);
+
+        SolverResult result{start_key, 0.0};
+        Vector(uint8)& key = result.key;
+        if (restart > 0) {
+            for (uint8& shift : key) {
+                shift = random_shift(generator);
+            }
+        }
+
+        Vector(uint8) plaintext(indices, indices + size);
+        Vector(uint8) letters;
+        for (uint32 column = 0; column < key_length; ++column) {
+            decipher(column, key[column], letters);
+            for (datatype_size i = 0; i < letters.size(); ++i) {
+                plaintext[column_positions[column][i]] = letters[i];
+            }
+        }
+        IncrementalFitness state(model, std::move(plaintext));
+
+        Vector(uint8) best_key = key;
+        uint32 column = 0;
+        uint8 previous_shift = 0;
+        anneal(options, generator, state.getFitness(),
+               [&] {
+                   column = random_column(generator);
+                   previous_shift = key[column];
+                   key[column] = (previous_shift + 1 + random_shift(generator) % (alphabet_size - 1)) % alphabet_size;
+                   decipher(column, key[column], letters);
+                   return state.change(column_positions[column], letters);
+               },
+               [&] {
+                   state.undo();
+                   key[column] = previous_shift;
+               },
+               [&](float64 fitness) {
+                   best_key = key;
+                   result.fitness = fitness;
+               });
+        key = std::move(best_key);
+        return result;
+    });
+}
+
+SolverResult CipherSolver::solveSubstitution(const uint8* indices, datatype_size size, const LanguageModel& model,
+                                             ThreadPool& pool, const SolverOptions& options) {
+    checkModel(model);
+    const uint32 alphabet_size = model.getAlphabetSize();
+
+    // The positions of each ciphertext letter.
+    Vector(Vector(uint32)) letter_positions(alphabet_size);
+    for (datatype_size i = 0; i < size; ++i) {
+        if (indices[i] < alphabet_size) {
+            letter_positions[indices[i]].push_back(i);
+        }
+    }
+
+    // Match the letters by frequency rank, most frequent first, ties by letter.
+    auto byRank = [](Vector(uint32) letters, auto frequency) {
+        std::stable_sort(letters.begin(), letters.end(),
+                         [&](uint32 a, uint32 b) { return frequency(a) > frequency(b); });
+        return letters;
+    };
+    Vector(uint32) alphabet(alphabet_size);
+    std::iota(alphabet.begin(), alphabet.end(), 0);
+    const Vector(float64) frequencies = model.getLetterFrequencies();
+    const Vector(uint32) cipher_rank = byRank(alphabet, [&](uint32 letter) { return letter_positions[letter].size(); });
+    const Vector(uint32) plain_rank = byRank(alphabet, [&](uint32 letter) { return frequencies[letter]; });
+    Vector(uint8) start_key(alphabet_size);
+    for (uint32 rank = 0; rank < alphabet_size; ++rank) {
+        start_key[cipher_rank[rank]] = plain_rank[rank];
+    }
+
+    return runSearches(options, pool, [&](uint32 restart) {
+        std::mt19937_64 generator(options.seed + restart);
+        std::uniform_int_distribution<uint32> random_letter(0, alphabet_size - 1);
+
+        SolverResult result{start_key, 0.0};
+        Vector(uint8)& key = result.key;
+        if (restart > 0) {
+            std::shuffle(key.begin(), key.end(), generator);
+        }
+
+        Vector(uint8) plaintext(size);
+        for (datatype_size i = 0; i < size; ++i) {
+            plaintext[i] = indices[i] < alphabet_size ? key[indices[i]] : indices[i];
+        }
+        IncrementalFitness state(model, std::move(plaintext));
+
+        Vector(uint8) best_key = key;
+        Vector(uint32) positions;
+        Vector(uint8) letters;
+        uint32 first = 0;
+        uint32 second = 0;
+        anneal(options, generator, state.getFitness(),
+               [&] {
+                   first = random_letter(generator);
+                   second = (first + 1 + random_letter(generator) % (alphabet_size - 1)) % alphabet_size;
+                   std::swap(key[first], key[second]);
+                   const Vector(uint32)& a = letter_positions[first];
+                   const Vector(uint32)& b = letter_positions[second];
+                   positions.resize(a.size() + b.size());
+                   std::merge(a.begin(), a.end(), b.begin(), b.end(), positions.begin());
+                   letters.resize(positions.size());
+                   for (datatype_size i = 0; i < positions.size(); ++i) {
+                       letters[i] = key[indices[positions[i]]];
+                   }
+                   return state.change(positions, letters);
+               },
+               [&] {
+                   state.undo();
+                   std::swap(key[first], key[second]);
+               },
+               [&](float64 fitness) {
+                   best_key = key;
+                   result.fitness = fitness;
+               });
+        key = std::move(best_key);
+        return result;
+    });
+}
+
+String CipherSolver::solveVigenereKey(const String& message, uint32 key_length, const LanguageModel& model,
+                                      ThreadPool& pool, const SolverOptions& options) {
+    if (model.getAlphabetSize() != Utils::english_alphabet_size) {
+        throw std::invalid_argument("Text keys need a language with the 26-letter alphabet");
+    }
+    Vector(uint8) indices(message.size());
+    Utils::convertLettersToIndices(message.data(), message.size(), indices.data());
+
+    String key;
+    for (uint8 shift : solveVigenere(indices.data(), indices.size(), key_length, model, pool, options).key) {
+        key += Utils::convertIntToChar(shift);
+    }
+    return key;
+}
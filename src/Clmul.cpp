@@ -0,0 +1,224 @@
+#include "Clmul.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define CRYPTOGRAPHY1_X86_CLMUL 1
+#endif
+
+namespace {
+
+/**
+ * @brief Reverses the bit order of a 64-bit word.
+ */
+inline uint64 reverseBits(uint64 x) {
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    x = ((x >> 8) & 0x00FF00FF00FF00FFULL) | ((x & 0x00FF00FF00FF00FFULL) << 8);
+    x = ((x >> 16) & 0x0000FFFF0000FFFFULL) | ((x & 0x0000FFFF0000FFFFULL) << 16);
+    return (x >> 32) | (x << 32);
+}
+
+/**
+ * @brief Low 64 bits of a carry-less product, using integer multiplies on bit-sliced operands.
+ * @details Each operand is split into four interleaved lanes holding every fourth bit. A lane product
+ *          sums at most 16 one-bit terms per column, and the three zero bits between lane bits absorb
+ *          every carry that can land below bit 64, so masking the integer products recovers the XOR sum.
+ */
+inline uint64 bitslicedMultiplyLow(uint64 x, uint64 y) {
+    const uint64 m0 = 0x1111111111111111ULL;
+    const uint64 m1 = 0x2222222222222222ULL;
+    const uint64 m2 = 0x4444444444444444ULL;
+    const uint64 m3 = 0x8888888888888888ULL;
+
+    const uint64 x0 = x & m0, x1 = x & m1, x2 = x & m2, x3 = x & m3;
+    const uint64 y0 = y & m0, y1 = y & m1, y2 = y & m2, y3 = y & m3;
+
+    uint64 z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+    uint64 z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+    uint64 z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+    uint64 z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+
+    return (z0 & m0) | (z1 & m1) | (z2 & m2) | (z3 & m3);
+}
+
+inline void scalarMultiplyWord(uint64 a, uint64 b, uint64& low, uint64& high) {
+    low = bitslicedMultiplyLow(a, b);
+    // The high half is the low half of the product of the bit-reversed operands, reversed back.
+    high = reverseBits(bitslicedMultiplyLow(reverseBits(a), reverseBits(b))) >> 1;
+}
+
+void schoolbookScalar(const uint64* a, datatype_size a_size, const uint64* b, datatype_size b_size, uint64* out) {
+    std::fill(out, out + a_size + b_size, 0);
+    for (datatype_size i = 0; i < a_size; ++i) {
+        if (a[i] == 0) {
+            continue;
+        }
+        for (datatype_size j = 0; j < b_size; ++j) {
+            uint64 low, high;
+            scalarMultiplyWord(a[i], b[j], low, high);
+            out[i + j] ^= low;
+            out[i + j + 1] ^= high;
+        }
+    }
+}
+
+#ifdef CRYPTOGRAPHY1_X86_CLMUL
+__attribute__((target("sse2,pclmul")))
+void schoolbookPclmul(const uint64* a, datatype_size a_size, const uint64* b, datatype_size b_size, uint64* out) {
+    std::fill(out, out + a_size + b_size, 0);
+    for (datatype_size i = 0; i < a_size; ++i) {
+        if (a[i] == 0) {
+            continue;
+        }
+        const __m128i lhs = _mm_cvtsi64_si128(static_cast<long long>(a[i]));
+        for (datatype_size j = 0; j < b_size; ++j) {
+            const __m128i rhs = _mm_cvtsi64_si128(static_cast<long long>(b[j]));
+            const __m128i product = _mm_clmulepi64_si128(lhs, rhs, 0x00);
+            out[i + j] ^= static_cast<uint64>(_mm_cvtsi128_si64(product));
+            out[i + j + 1] ^= static_cast<uint64>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(product, product)));
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Spreads the 32 bits of a word to the even bit positions of a 64-bit word.
+ */
+inline uint64 spreadBits(uint64 x) {
+    x &= 0xFFFFFFFFULL;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+}
+
+} // namespace
+
+Clmul::SchoolbookKernel Clmul::selectKernel() {
+#ifdef CRYPTOGRAPHY1_X86_CLMUL
+    if (__builtin_cpu_supports("pclmul")) {
+        return schoolbookPclmul;
+    }
+#endif
+    return schoolbookScalar;
+}
+
+bool Clmul::hasHardwareSupport() {
+#ifdef CRYPTOGRAPHY1_X86_CLMUL
+    return selectKernel() == schoolbookPclmul;
+#else
+    return false;
+#endif
+}
+
+void Clmul::multiplyWord(uint64 a, uint64 b, uint64& low, uint64& high) {
+    static const SchoolbookKernel kernel = selectKernel();
+    uint64 product[2];
+    kernel(&a, 1, &b, 1, product);
+    low = product[0];
+    high = product[1];
+}
+
+void Clmul::multiply(const uint64* a, datatype_size a_size, const uint64* b, datatype_size b_size, uint64* out) {
+    Vector(uint64) scratch(multiplyScratchSize(a_size, b_size));
+    multiply(a, a_size, b, b_size, out, scratch.data());
+}
+
+void Clmul::multiply(const uint64* a, datatype_size a_size, const uint64* b, datatype_size b_size, uint64* out,
+                     uint64* scratch) {
+    static const SchoolbookKernel kernel = selectKernel();
+
+    if (a_size < b_size) {
+        std::swap(a, b);
+        std::swap(a_size, b_size);
+    }
+    if (b_size < karatsuba_threshold) {
+        kernel(a, a_size, b, b_size, out);
+        return;
+    }
+
+    // Cut the longer operand into blocks as long as the shorter one and run a balanced Karatsuba per block.
+    const datatype_size block = b_size;
+    uint64* padded = scratch;
+    uint64* product = scratch + block;
+    uint64* karatsuba_scratch = scratch + 3 * block;
+
+    std::fill(out, out + a_size + b_size, 0);
+    for (datatype_size offset = 0; offset < a_size; offset += block) {
+        const datatype_size length = std::min(block, a_size - offset);
+        const uint64* lhs = a + offset;
+        if (length < block) {
+            std::copy(lhs, lhs + length, padded);
+            std::fill(padded + length, padded + block, 0);
+            lhs = padded;
+        }
+        karatsuba(lhs, b, block, product, karatsuba_scratch);
+
+        const datatype_size limit = std::min(2 * block, a_size + b_size - offset);
+        for (datatype_size i = 0; i < limit; ++i) {
+            out[offset + i] ^= product[i];
+        }
+    }
+}
+
+datatype_size Clmul::multiplyScratchSize(datatype_size a_size, datatype_size b_size) {
+    const datatype_size block = std::min(a_size, b_size);
+    return block < karatsuba_threshold ? 0 : 3 * block + scratchSize(block);
+}
+
+void Clmul::square(const uint64* a, datatype_size a_size, uint64* out) {
+    for (datatype_size i = 0; i < a_size; ++i) {
+        out[2 * i] = spreadBits(a[i]);
+        out[2 * i + 1] = spreadBits(a[i] >> 32);
+    }
+}
+
+datatype_size Clmul::scratchSize(datatype_size size) {
+    datatype_size total = 0;
+    while (size >= karatsuba_threshold) {
+        const datatype_size high = size - size / 2;
+        total += 4 * high;
+        size = high;
+    }
+    return total;
+}
+
+void Clmul::karatsuba(const uint64* a, const uint64* b, datatype_size size, uint64* out, uint64* scratch) {
+    static const SchoolbookKernel kernel = selectKernel();
+    if (size < karatsuba_threshold) {
+        kernel(a, size, b, size, out);
+        return;
+    }
+
+    const datatype_size low = size / 2;
+    const datatype_size high = size - low;
+
+    // z0 = a0 * b0 and z2 = a1 * b1 land directly in their final positions.
+    karatsuba(a, b, low, out, scratch);
+    karatsuba(a + low, b + low, high, out + 2 * low, scratch);
+
+    uint64* a_sum = scratch;
+    uint64* b_sum = scratch + high;
+    uint64* middle = scratch + 2 * high;
+    for (datatype_size i = 0; i < high; ++i) {
+        a_sum[i] = a[low + i] ^ (i < low ? a[i] : 0);
+        b_sum[i] = b[low + i] ^ (i < low ? b[i] : 0);
+    }
+
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2, where both + and - are XOR.
+    karatsuba(a_sum, b_sum, high, middle, scratch + 4 * high);
+    for (datatype_size i = 0; i < 2 * low; ++i) {
+        middle[i] ^= out[i];
+    }
+    for (datatype_size i = 0; i < 2 * high; ++i) {
+        middle[i] ^= out[2 * low + i];
+    }
+    for (datatype_size i = 0; i < 2 * high; ++i) {
+        out[low + i] ^= middle[i];
+    }
+}
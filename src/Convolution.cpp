@@ -0,0 +1,308 @@
+#include "Convolution.h"
+#include "Math.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief An NTT-friendly prime p = c * 2^k + 1 together with a primitive root.
+ */
+struct NttPrime {
+    uint32 prime;
+    uint32 generator;
+};
+
+// The product of the three primes is about 2^86, enough to recover sums of up to 2^22 products of
+// two 32-bit values exactly before reducing modulo 2^32.
+constexpr Array(NttPrime, 3) ntt_primes = {{{998244353, 3}, {167772161, 3}, {469762049, 3}}};
+
+// 998244353 - 1 = 119 * 2^23 limits the transform length of the smallest prime.
+constexpr datatype_size max_ntt_size = 1ULL << 23;
+
+/**
+ * @brief Branch-free a + b mod p for a, b < p < 2^31: when the sum is already below p, sum - p wraps above it.
+ */
+inline uint32 addModulo(uint32 a, uint32 b, uint32 prime) {
+    const uint32 sum = a + b;
+    return std::min(sum, sum - prime);
+}
+
+/**
+ * @brief Branch-free a - b mod p for a, b < p < 2^31.
+ */
+inline uint32 subtractModulo(uint32 a, uint32 b, uint32 prime) {
+    const uint32 difference = a - b;
+    return std::min(difference, difference + prime);
+}
+
+Vector(uint32) toUnsigned(const Vector(int32)& values) {
+    return Vector(uint32)(values.begin(), values.end());
+}
+
+Vector(int32) toSigned(const Vector(uint32)& values) {
+    return Vector(int32)(values.begin(), values.end());
+}
+
+} // namespace
+
+Vector(int32) Convolution::multiply(const Vector(int32)& a, const Vector(int32)& b) {
+    return toSigned(multiplyUnsigned(toUnsigned(a), toUnsigned(b)));
+}
+
+Vector(int32) Convolution::inverseSeries(const Vector(int32)& f, datatype_size precision) {
+    if (f.empty() || (f[0] != 1 && f[0] != -1)) {
+        throw std::invalid_argument("Series must have a constant term of 1 or -1");
+    }
+
+    const Vector(uint32) series = toUnsigned(f);
+    // 1 and -1 are their own inverses.
+    Vector(uint32) inverse = {series[0]};
+    datatype_size length = 1;
+    while (length < precision) {
+        length = std::min(2 * length, precision);
+
+        Vector(uint32) truncated(series.begin(), series.begin() + std::min(length, series.size()));
+        Vector(uint32) error = multiplyUnsigned(truncated, inverse);
+        error.resize(length, 0);
+        // error = 2 - f * g
+        for (uint32& value : error) {
+            value = 0u - value;
+        }
+        error[0] += 2;
+
+        inverse = multiplyUnsigned(inverse, error);
+        inverse.resize(length, 0);
+    }
+    inverse.resize(precision, 0);
+    return toSigned(inverse);
+}
+
+Vector(uint32) Convolution::multiplyUnsigned(const Vector(uint32)& a, const Vector(uint32)& b) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+
+    const datatype_size shorter = std::min(a.size(), b.size());
+    const datatype_size result_size = a.size() + b.size() - 1;
+    if (shorter < karatsuba_threshold) {
+        Vector(uint32) result(result_size + 1, 0);
+        schoolbook(a.data(), a.size(), b.data(), b.size(), result.data());
+        result.resize(result_size);
+        return result;
+    }
+    if (shorter < ntt_threshold || std::bit_ceil(result_size) > max_ntt_size) {
+        return multiplyKaratsuba(a, b);
+    }
+    return multiplyNtt(a, b);
+}
+
+void Convolution::schoolbook(const uint32* a, datatype_size a_size, const uint32* b, datatype_size b_size, uint32* out) {
+    std::fill(out, out + a_size + b_size, 0);
+    for (datatype_size i = 0; i < a_size; ++i) {
+        if (a[i] == 0) {
+            continue;
+        }
+        for (datatype_size j = 0; j < b_size; ++j) {
+            out[i + j] += a[i] * b[j];
+        }
+    }
+}
+
+datatype_size Convolution::karatsubaScratchSize(datatype_size size) {
+    datatype_size total = 0;
+    while (size >= karatsuba_threshold) {
+        const datatype_size high = size - size / 2;
+        total += 4 * high;
+        size = high;
+    }
+    return total;
+}
+
+void Convolution::karatsuba(const uint32* a, const uint32* b, datatype_size size, uint32* out, uint32* scratch) {
+    if (size < karatsuba_threshold) {
+        schoolbook(a, size, b, size, out);
+        return;
+    }
+
+    const datatype_size low = size / 2;
+    const datatype_size high = size - low;
+
+    karatsuba(a, b, low, out, scratch);
+    karatsuba(a + low, b + low, high, out + 2 * low, scratch);
+
+    uint32* a_sum = scratch;
+    uint32* b_sum = scratch + high;
+    uint32* middle = scratch + 2 * high;
+    for (datatype_size i = 0; i < high; ++i) {
+        a_sum[i] = a[low + i] + (i < low ? a[i] : 0);
+        b_sum[i] = b[low + i] + (i < low ? b[i] : 0);
+    }
+
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+    karatsuba(a_sum, b_sum, high, middle, scratch + 4 * high);
+    for (datatype_size i = 0; i < 2 * low; ++i) {
+        middle[i] -= out[i];
+    }
+    for (datatype_size i = 0; i < 2 * high; ++i) {
+        middle[i] -= out[2 * low + i];
+    }
+    for (datatype_size i = 0; i < 2 * high; ++i) {
+        out[low + i] += middle[i];
+    }
+}
+
+Vector(uint32) Convolution::multiplyKaratsuba(const Vector(uint32)& a, const Vector(uint32)& b) {
+    const Vector(uint32)& longer = a.size() >= b.size() ? a : b;
+    const Vector(uint32)& shorter = a.size() >= b.size() ? b : a;
+
+    // Cut the longer operand into blocks as long as the shorter one and run a balanced Karatsuba per block.
+    const datatype_size block = shorter.size();
+    Vector(uint32) padded(block, 0);
+    Vector(uint32) product(2 * block, 0);
+    Vector(uint32) scratch(karatsubaScratchSize(block), 0);
+    Vector(uint32) result(longer.size() + block, 0);
+
+    for (datatype_size offset = 0; offset < longer.size(); offset += block) {
+        const datatype_size length = std::min(block, longer.size() - offset);
+        const uint32* lhs = longer.data() + offset;
+        if (length < block) {
+            std::copy(lhs, lhs + length, padded.begin());
+            std::fill(padded.begin() + length, padded.end(), 0);
+            lhs = padded.data();
+        }
+        karatsuba(lhs, shorter.data(), block, product.data(), scratch.data());
+
+        const datatype_size limit = std::min(2 * block, result.size() - offset);
+        for (datatype_size i = 0; i < limit; ++i) {
+            result[offset + i] += product[i];
+        }
+    }
+
+    result.resize(a.size() + b.size() - 1);
+    return result;
+}
+
+void Convolution::ntt(Vector(uint32)& values, const Montgomery<uint32>& field, uint32 generator, bool inverse) {
+    // Local copies, since stores through `data` could otherwise alias the modulus and force reloads.
+    const Montgomery<uint32> arithmetic = field;
+    uint32* const data = values.data();
+    const datatype_size size = values.size();
+    const uint32 prime = arithmetic.getModulus();
+
+    // roots[half + k] = w^k for a primitive (2 * half)-th root of unity w, so every stage reads its twiddles
+    // contiguously. The smaller roots are the even powers of the larger ones.
+    const datatype_size top = size / 2;
+    Vector(uint32) roots(std::max<datatype_size>(size, 1));
+    if (top > 0) {
+        const uint64 exponent = inverse ? (prime - 1) - (prime - 1) / size : (prime - 1) / size;
+        const uint32 root = arithmetic.power(arithmetic.toMontgomery(generator), exponent);
+        roots[top] = arithmetic.one();
+        for (datatype_size k = 1; k < top; ++k) {
+            roots[top + k] = arithmetic.multiply(roots[top + k - 1], root);
+        }
+        for (datatype_size half = top / 2; half > 0; half /= 2) {
+            for (datatype_size k = 0; k < half; ++k) {
+                roots[half + k] = roots[2 * half + 2 * k];
+            }
+        }
+    }
+
+    if (!inverse) {
+        // Decimation in frequency: natural order in, bit-reversed order out.
+        for (datatype_size half = top; half > 0; half /= 2) {
+            const uint32* twiddles = roots.data() + half;
+            for (datatype_size start = 0; start < size; start += 2 * half) {
+                for (datatype_size k = 0; k < half; ++k) {
+                    const uint32 even = data[start + k];
+                    const uint32 odd = data[start + k + half];
+                    data[start + k] = addModulo(even, odd, prime);
+                    data[start + k + half] = arithmetic.multiply(subtractModulo(even, odd, prime), twiddles[k]);
+                }
+            }
+        }
+        return;
+    }
+
+    // Decimation in time: bit-reversed order in, natural order out, so neither direction permutes.
+    for (datatype_size half = 1; half <= top; half *= 2) {
+        const uint32* twiddles = roots.data() + half;
+        for (datatype_size start = 0; start < size; start += 2 * half) {
+            for (datatype_size k = 0; k < half; ++k) {
+                const uint32 even = data[start + k];
+                const uint32 odd = arithmetic.multiply(data[start + k + half], twiddles[k]);
+                data[start + k] = addModulo(even, odd, prime);
+                data[start + k + half] = subtractModulo(even, odd, prime);
+            }
+        }
+    }
+
+    // A Montgomery multiply by the standard form of 1 / size divides and leaves Montgomery form in one pass.
+    const uint32 size_inverse = static_cast<uint32>(Math::powMod(size % prime, prime - 2, prime));
+    for (datatype_size i = 0; i < size; ++i) {
+        data[i] = arithmetic.multiply(data[i], size_inverse);
+    }
+}
+
+Vector(uint32) Convolution::multiplyNtt(const Vector(uint32)& a, const Vector(uint32)& b) {
+    const datatype_size result_size = a.size() + b.size() - 1;
+
+    // A cyclic transform of length N yields c[i] + c[i + N]. The top t = result_size - N coefficients of the
+    // product only involve the top t coefficients of each operand, so when t is small they are multiplied
+    // separately and subtracted back out, instead of doubling the transform length to the next power of two.
+    datatype_size size = std::bit_ceil(result_size);
+    datatype_size overflow = 0;
+    if (!std::has_single_bit(result_size) && result_size - size / 2 <= std::min(size / 4, std::min(a.size(), b.size()))) {
+        size /= 2;
+        overflow = result_size - size;
+    }
+
+    Array(Vector(uint32), 3) residues;
+    for (datatype_size p = 0; p < ntt_primes.size(); ++p) {
+        const NttPrime& ntt_prime = ntt_primes[p];
+        const Montgomery<uint32> field(ntt_prime.prime);
+        Vector(uint32) lhs(size, 0), rhs(size, 0);
+        // Operands longer than the transform are reduced modulo x^N - 1 by folding.
+        for (datatype_size i = 0; i < a.size(); ++i) {
+            lhs[i % size] = field.add(lhs[i % size], field.toMontgomery(a[i]));
+        }
+        for (datatype_size i = 0; i < b.size(); ++i) {
+            rhs[i % size] = field.add(rhs[i % size], field.toMontgomery(b[i]));
+        }
+        ntt(lhs, field, ntt_prime.generator, false);
+        ntt(rhs, field, ntt_prime.generator, false);
+        for (datatype_size i = 0; i < size; ++i) {
+            lhs[i] = field.multiply(lhs[i], rhs[i]);
+        }
+        ntt(lhs, field, ntt_prime.generator, true);
+        residues[p] = std::move(lhs);
+    }
+
+    // Garner's CRT: x = x1 + x2 * p1 + x3 * p1 * p2, evaluated modulo 2^32 at the end.
+    const uint64 p1 = ntt_primes[0].prime;
+    const uint64 p2 = ntt_primes[1].prime;
+    const uint64 p3 = ntt_primes[2].prime;
+    const uint64 p1_inverse_mod_p2 = Math::powMod(p1 % p2, p2 - 2, p2);
+    const uint64 p1p2_inverse_mod_p3 = Math::powMod(p1 * p2 % p3, p3 - 2, p3);
+
+    Vector(uint32) result(result_size);
+    for (datatype_size i = 0; i < result_size - overflow; ++i) {
+        const uint64 x1 = residues[0][i];
+        const uint64 x2 = (residues[1][i] + p2 - x1 % p2) % p2 * p1_inverse_mod_p2 % p2;
+        const uint64 partial = (x1 + x2 * p1) % p3;
+        const uint64 x3 = (residues[2][i] + p3 - partial) % p3 * p1p2_inverse_mod_p3 % p3;
+        result[i] = static_cast<uint32>(x1 + x2 * p1 + x3 * p1 * p2);
+    }
+
+    if (overflow > 0) {
+        // c[N + j] is coefficient t - 1 + j of the product of the top t coefficients, and wrapped onto c[j].
+        const Vector(uint32) top = multiplyUnsigned(Vector(uint32)(a.end() - overflow, a.end()),
+                                                    Vector(uint32)(b.end() - overflow, b.end()));
+        for (datatype_size j = 0; j < overflow; ++j) {
+            result[size + j] = top[overflow - 1 + j];
+            result[j] -= result[size + j];
+        }
+    }
+    return result;
+}
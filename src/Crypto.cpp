@@ -2,236 +2,43 @@
 #include <iostream>
 #include <random>
 #include <algorithm>
-#include "Math.h"
-#include "Utils.h"
-
-#include <openssl/aes.h>
-#include <openssl/rand.h>
-#include <openssl/evp.h>
-
-Vector(WordOccurrences) Crypto::findRecurringWords(const String &message, const uint32 minLength) {
-    if (message.length() < minLength || minLength == 0) {
-        return {};
-    }
-
-    // 1. Generate all substrings of length minLength
-    Vector(String) substrings;
-    for (uint32 i = 0; i <= message.length() - minLength; ++i) {
-        substrings.push_back(message.substr(i, minLength));
-    }
-
-    // 2. Sort to group identical substrings
-    std::sort(substrings.begin(), substrings.end());
-
-    // 3. Count occurrences and identify recurring ones
-    Vector(WordOccurrences) recurringWords;
-    if (substrings.empty()) {
-        return recurringWords;
-    }
-
-    String currentWord = substrings[0];
-    uint32 currentCount = 1;
-
-    for (size_t i = 1; i < substrings.size(); ++i) {
-        if (substrings[i] == currentWord) {
-            currentCount++;
-        } else {
-            if (currentCount > 1) {
-                recurringWords.push_back({currentCount, currentWord});
-            }
-            currentWord = substrings[i];
-            currentCount = 1;
-        }
-    }
-    if (currentCount > 1) {
-        recurringWords.push_back({currentCount, currentWord});
-    }
-    // 4. Sort the results by count in descending order
-    std::sort(recurringWords.begin(), recurringWords.end(), [](const WordOccurrences& a, const WordOccurrences& b) {
-        return a.count > b.count;
-    });
-
-    return recurringWords;
-}
-
-Vector(uint32) Crypto::findDistances(const String &message, const String& word) {
-    Vector(uint32) distances;
-    Vector(uint32) occurrences;
-
-    for (uint32 i = 0; i + word.length() <= message.length(); ++i) {
-        if (message.substr(i, word.length()) == word) {
-            occurrences.push_back(i);
-        }
-    }
-
-    for (uint32 i = 1; i < occurrences.size(); ++i) {
-        distances.push_back(occurrences[i] - occurrences[i-1]);
-    }
-
-    return distances;
-}
-
-Vector(String) Crypto::splitEncryptedMessageReturnRows(const String &message, uint32 keyLength) {
-    if (keyLength == 0) {
-        return {};
-    }
-
-    Vector(String) columns = splitEncryptedMessageReturnColumns(message, keyLength);
-    return Utils::transposeVectorString(columns);
-}
-
-Vector(String) Crypto::splitEncryptedMessageReturnColumns(const String &message, const uint32 keyLength) {
-    Vector(String) columns(keyLength); // Initialize with keyLength empty strings
-
-    if (keyLength == 0) {
-        return {}; // Handle invalid keyLength
-    }
-
-    for (uint32 i = 0; i < message.length(); ++i) {
-        columns[i % keyLength] += message[i];
-    }
-
-    return columns;
-}
+#include <stdexcept>
+#include "AesContext.h"
+#include "FrequencyAnalysis.h"
+#include "Friedman.h"
+#include "Kasiski.h"
+#include "LanguageModel.h"
+#include "Vigenere.h"
 
 uint32 Crypto::findKeyLengthKasiski(const String &message, const uint32 min_word_length) {
-    Vector(WordOccurrences) occurrences = findRecurringWords(message, min_word_length);
-    if (occurrences.empty()) {
-        return 0; // Or handle error appropriately
-    }
-    Vector(uint32) word_distances = findDistances(message, occurrences[0].word);
-    uint32 key_lenght = Math::findGCD(word_distances);
-    return key_lenght;
-}
-
-char Crypto::findMostFrequentCharInString(const String& text) {
-    Map(char, int) charCounts;
-    int maxCount = 0;
-    char mostFrequent = ' '; // Default to space if no alphabetic chars
-
-    for (char c : text) {
-        if (std::isalpha(c)) {
-            char upper_c = std::toupper(c);
-            charCounts[upper_c]++;
-            if (charCounts[upper_c] > maxCount) {
-                maxCount = charCounts[upper_c];
-                mostFrequent = upper_c;
-            }
-        }
+    if (min_word_length == 0) {
+        return 0;
     }
-    return mostFrequent;
+    // Two occurrences of a repeat are at most half the message apart when the key repeats at least twice,
+    // so no key length above that can be detected anyway.
+    const uint32 max_key_length = std::max<uint32>(Kasiski::default_max_factor, message.size() / 2);
+    return Kasiski::analyze(message, min_word_length, max_key_length).key_length;
 }
 
 String Crypto::vigenereDecipher(const String &message, const String key) {
-    String decrypted_message;
-    decrypted_message.reserve(message.length());
-
-    for (size_t i = 0; i < message.length(); ++i) {
-        const int8 encrypted_char = Utils::convertCharToInt(message[i]);
-        const int8 key_char = Utils::convertCharToInt(key[i % key.length()]);
-
-        if (encrypted_char != -1) { // Check if the character is a letter
-            const char decrypted_char = Utils::convertIntToChar(Math::mod26(encrypted_char - key_char));
-            decrypted_message += decrypted_char;
-        } else {
-            // If the character is not a letter, append it as is.
-            decrypted_message += message[i];
-        }
-    }
-
+    String decrypted_message(message.size(), '\0');
+    Vigenere(key).decipher(message.data(), message.size(), decrypted_message.data());
     return decrypted_message;
 }
 
-float32 Crypto::calculateIC(const String& text) {
-    // Filter out non-alphabetic characters and convert to uppercase for consistent counting
-    String filteredText;
-    for (char c : text) {
-        if (std::isalpha(c)) {
-            filteredText += std::toupper(c);
-        }
-    }
-
-    if (filteredText.length() < 2) {
-        return 0.0; // Not enough characters to calculate IC
-    }
-
-    Map(char, int) charCounts;
-    for (char c : filteredText) {
-        charCounts[c]++;
-    }
-
-    float64 sum_fi_minus_1 = 0.0;
-    for (const auto& pair : charCounts) {
-        int fi = pair.second;
-        sum_fi_minus_1 += (float64)fi * (fi - 1.0);
-    }
-
-    float64 N = filteredText.length();
-    if (N * (N - 1) == 0) {
-        return 0.0; // Avoid division by zero if N is 0 or 1
-    }
-
-    return sum_fi_minus_1 / (N * (N - 1));
+String Crypto::vigenereEncipher(const String &message, const String& key) {
+    String encrypted_message(message.size(), '\0');
+    Vigenere(key).encipher(message.data(), message.size(), encrypted_message.data());
+    return encrypted_message;
 }
 
 uint32 Crypto::findKeyLengthFriedman(const String &message, const uint32 max_key_length) {
-    uint32  best_key_length = 0;
-    const float64 english_ic = 0.067;
-    float64 min_ic_difference = 1.0;
-
-    for (uint32 key_length = 2; key_length < max_key_length; key_length++) {
-
-        Vector(String) splitted_message_columns = splitEncryptedMessageReturnColumns(message, key_length);
-
-        Vector(float64) coincidence_indices;
-        for (const String& column : splitted_message_columns) {
-            coincidence_indices.push_back(calculateIC(column));
-        }
-
-        if (!coincidence_indices.empty()) {
-            float64 average_ic = Math::average(coincidence_indices);
-            float64 ic_difference = std::abs(average_ic - english_ic);
-
-            if (ic_difference < min_ic_difference) {
-                min_ic_difference = ic_difference;
-                best_key_length = key_length;
-            }
-        }
-    }
-
-    if (best_key_length == 0) {
-        return 1;
-    }
-
-    return best_key_length;
+    return Friedman::findKeyLength(message, max_key_length, LanguageModel::english().getExpectedIC());
 }
 
 String Crypto::getKeyWithFrequencyAnalysis(const String &message, uint32 key_length) {
-    if (key_length == 0) {
-        return "";
-    }
-    const Vector(String) text_columns = splitEncryptedMessageReturnColumns(message, key_length);
-    String key;
-    key.reserve(key_length);
-    for (const auto &column : text_columns) {
-        char char_to_append;
-        if (column.empty()) {
-            char_to_append = '?';
-        } else {
-            const char most_frequent_english_char = 'E';
-            const char most_frequent_in_column = findMostFrequentCharInString(column);
-            if (most_frequent_in_column == ' ') {
-                // No alphabetic characters in the column
-                char_to_append = '?';
-            } else {
-                // Calculate the shift
-                const int8 shift = Utils::convertCharToInt(most_frequent_in_column) - Utils::convertCharToInt(most_frequent_english_char);
-                char_to_append = Utils::convertIntToChar(Math::mod26(shift));
-            }
-        }
-        key += char_to_append;
-    }
-    return key;
+    static const FrequencyAnalysis english;
+    return english.recoverKey(message, key_length);
 }
 
 uint16 Crypto::decrypt16bit(const uint16 encrypted_msg) {
@@ -307,78 +114,23 @@ int32 Crypto::countDiffBits(const String& data1, const String& data2) {
 }
 
 String Crypto::encryptECB(const String& key, const String& plaintext) {
-    if (key.length() != 16) {
-        throw std::length_error("Key must be 16 bytes for AES-128.");
-    }
-
-    EVP_CIPHER_CTX *ctx;
-    int len;
-    int ciphertext_len;
-
-    // Create and initialise the context
-    if(!(ctx = EVP_CIPHER_CTX_new()))
-        throw std::runtime_error("Failed to create new EVP_CIPHER_CTX");
-
-    // Initialise the encryption operation.
-    if(1 != EVP_EncryptInit_ex(ctx, EVP_aes_128_ecb(), NULL, reinterpret_cast<const unsigned char*>(key.c_str()), NULL))
-        throw std::runtime_error("Failed to initialize encryption");
-
-    String ciphertext;
-    ciphertext.resize(plaintext.length() + AES_BLOCK_SIZE); // Make room for padding
-
-    // Provide the message to be encrypted, and obtain the encrypted output.
-    if(1 != EVP_EncryptUpdate(ctx, reinterpret_cast<unsigned char*>(&ciphertext[0]), &len, reinterpret_cast<const unsigned char*>(plaintext.c_str()), plaintext.length()))
-        throw std::runtime_error("Failed to update encryption");
-    ciphertext_len = len;
-
-    // Finalise the encryption.
-    if(1 != EVP_EncryptFinal_ex(ctx, reinterpret_cast<unsigned char*>(&ciphertext[0]) + len, &len))
-        throw std::runtime_error("Failed to finalize encryption");
-    ciphertext_len += len;
-
-    // Clean up
-    EVP_CIPHER_CTX_free(ctx);
+    return AesContext(AesMode::ECB, key).process(plaintext);
+}
 
-    ciphertext.resize(ciphertext_len);
-    return ciphertext;
+String Crypto::decryptECB(const String& key, const String& ciphertext) {
+    return AesContext(AesMode::ECB, key, "", AesDirection::Decrypt).process(ciphertext);
 }
 
 String Crypto::encryptCBC(const String& key, const String& iv, const String& plaintext) {
-    if (key.length() != 16) {
-        throw std::length_error("Key must be 16 bytes for AES-128.");
-    }
-    if (iv.length() != 16) {
+    if (iv.length() != AesContext::block_size) {
         throw std::length_error("IV must be 16 bytes for AES-128.");
     }
+    return AesContext(AesMode::CBC, key, iv).process(plaintext);
+}
 
-    EVP_CIPHER_CTX *ctx;
-    int len;
-    int ciphertext_len;
-
-    // Create and initialise the context
-    if(!(ctx = EVP_CIPHER_CTX_new()))
-        throw std::runtime_error("Failed to create new EVP_CIPHER_CTX");
-
-    // Initialise the encryption operation.
-    if(1 != EVP_EncryptInit_ex(ctx, EVP_aes_128_cbc(), NULL, reinterpret_cast<const unsigned char*>(key.c_str()), reinterpret_cast<const unsigned char*>(iv.c_str())))
-        throw std::runtime_error("Failed to initialize encryption");
-
-    String ciphertext;
-    ciphertext.resize(plaintext.length() + AES_BLOCK_SIZE); // Make room for padding
-
-    // Provide the message to be encrypted, and obtain the encrypted output.
-    if(1 != EVP_EncryptUpdate(ctx, reinterpret_cast<unsigned char*>(&ciphertext[0]), &len, reinterpret_cast<const unsigned char*>(plaintext.c_str()), plaintext.length()))
-        throw std::runtime_error("Failed to update encryption");
-    ciphertext_len = len;
-
-    // Finalise the encryption.
-    if(1 != EVP_EncryptFinal_ex(ctx, reinterpret_cast<unsigned char*>(&ciphertext[0]) + len, &len))
-        throw std::runtime_error("Failed to finalize encryption");
-    ciphertext_len += len;
-
-    // Clean up
-    EVP_CIPHER_CTX_free(ctx);
-
-    ciphertext.resize(ciphertext_len);
-    return ciphertext;
-}
\ No newline at end of file
+String Crypto::decryptCBC(const String& key, const String& iv, const String& ciphertext) {
+    if (iv.length() != AesContext::block_size) {
+        throw std::length_error("IV must be 16 bytes for AES-128.");
+    }
+    return AesContext(AesMode::CBC, key, iv, AesDirection::Decrypt).process(ciphertext);
+}
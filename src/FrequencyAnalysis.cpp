@@ -0,0 +1,148 @@
+#include "FrequencyAnalysis.h"
+#include "Friedman.h"
+#include "Utils.h"
+#include <algorithm>
+#include <stdexcept>
+
+FrequencyAnalysis::FrequencyAnalysis(const LanguageModel& model)
+    : alphabet_size(model.getAlphabetSize()),
+      rotated_weights(static_cast<datatype_size>(alphabet_size) * alphabet_size) {
+    const Vector(float64) frequencies = model.getLetterFrequencies();
+    for (uint32 shift = 0; shift < alphabet_size; ++shift) {
+        for (uint32 letter = 0; letter < alphabet_size; ++letter) {
+            rotated_weights[shift * alphabet_size + letter] =
+                1.0 / frequencies[(letter + alphabet_size - shift) % alphabet_size];
+        }
+    }
+}
+
+uint32 FrequencyAnalysis::getAlphabetSize() const {
+    return alphabet_size;
+}
+
+void FrequencyAnalysis::scoreShifts(const uint32* counts, float64* chi_squared) const {
+    // Alphabets have at most 255 letters, so the squares fit on the stack.
+    Array(float64, 255) squares;
+    float64 letters = 0.0;
+    for (uint32 letter = 0; letter < alphabet_size; ++letter) {
+        const float64 count = counts[letter];
+        squares[letter] = count * count;
+        letters += count;
+    }
+    if (letters == 0.0) {
+        std::fill(chi_squared, chi_squared + alphabet_size, 0.0);
+        return;
+    }
+
+    for (uint32 shift = 0; shift < alphabet_size; ++shift) {
+        const float64* weights = rotated_weights.data() + shift * alphabet_size;
+        float64 sum = 0.0;
+        for (uint32 letter = 0; letter < alphabet_size; ++letter) {
+            sum += squares[letter] * weights[letter];
+        }
+        chi_squared[shift] = sum / letters - letters;
+    }
+}
+
+void FrequencyAnalysis::scoreShifts(const StridedView& column, float64* chi_squared) const {
+    checkEnglishAlphabet();
+    Array(uint32, Utils::english_alphabet_size + 1) counts = {};
+    Utils::countLetters(column, counts.data());
+    scoreShifts(counts.data(), chi_squared);
+}
+
+uint8 FrequencyAnalysis::recoverShift(const StridedView& column) const {
+    checkEnglishAlphabet();
+    Array(uint32, Utils::english_alphabet_size + 1) counts = {};
+    Utils::countLetters(column, counts.data());
+    if (std::all_of(counts.begin(), counts.end() - 1, [](uint32 count) { return count == 0; })) {
+        return alphabet_size;
+    }
+    Array(float64, Utils::english_alphabet_size) chi_squared;
+    scoreShifts(counts.data(), chi_squared.data());
+    return std::min_element(chi_squared.begin(), chi_squared.end()) - chi_squared.begin();
+}
+
+Vector(float64) FrequencyAnalysis::scoreColumns(const uint8* indices, datatype_size size, uint32 key_length) const {
+    if (key_length == 0) {
+        return {};
+    }
+    Vector(uint32) counts(static_cast<datatype_size>(key_length) * (alphabet_size + 1), 0);
+    Friedman::countColumns(indices, size, alphabet_size, key_length, 0, counts.data());
+
+    Vector(float64) scores(static_cast<datatype_size>(key_length) * alphabet_size);
+    for (uint32 column = 0; column < key_length; ++column) {
+        scoreShifts(counts.data() + column * (alphabet_size + 1), scores.data() + column * alphabet_size);
+    }
+    return scores;
+}
+
+Vector(float64) FrequencyAnalysis::scoreColumns(const String& message, uint32 key_length) const {
+    Vector(uint8) indices(message.size());
+    Utils::convertLettersToIndices(message.data(), message.size(), indices.data());
+    return scoreColumns(indices.data(), indices.size(), key_length);
+}
+
+Vector(Vector(ShiftScore)) FrequencyAnalysis::topShifts(const Vector(float64)& column_scores, uint32 k) const {
+    k = std::min(k, alphabet_size);
+    const datatype_size key_length = column_scores.size() / alphabet_size;
+    Vector(Vector(ShiftScore)) top(key_length);
+    Vector(ShiftScore) shifts(alphabet_size);
+    for (datatype_size column = 0; column < key_length; ++column) {
+        for (uint32 shift = 0; shift < alphabet_size; ++shift) {
+            shifts[shift] = {static_cast<uint8>(shift), column_scores[column * alphabet_size + shift]};
+        }
+        std::partial_sort(shifts.begin(), shifts.begin() + k, shifts.end(),
+                          [](const ShiftScore& a, const ShiftScore& b) {
+                              return a.chi_squared < b.chi_squared ||
+                                     (a.chi_squared == b.chi_squared && a.shift < b.shift);
+                          });
+        top[column].assign(shifts.begin(), shifts.begin() + k);
+    }
+    return top;
+}
+
+float64 FrequencyAnalysis::scoreKey(const Vector(float64)& column_scores, const uint8* shifts) const {
+    float64 score = 0.0;
+    const float64* const end = column_scores.data() + column_scores.size();
+    for (const float64* row = column_scores.data(); row != end; row += alphabet_size) {
+        score += row[*shifts++];
+    }
+    return score;
+}
+
+Vector(uint8) FrequencyAnalysis::recoverShifts(const uint8* indices, datatype_size size, uint32 key_length) const {
+    Vector(uint32) counts(static_cast<datatype_size>(key_length) * (alphabet_size + 1), 0);
+    Friedman::countColumns(indices, size, alphabet_size, key_length, 0, counts.data());
+
+    Vector(uint8) shifts(key_length);
+    Vector(float64) chi_squared(alphabet_size);
+    for (uint32 column = 0; column < key_length; ++column) {
+        const uint32* column_counts = counts.data() + column * (alphabet_size + 1);
+        if (std::all_of(column_counts, column_counts + alphabet_size, [](uint32 count) { return count == 0; })) {
+            shifts[column] = alphabet_size;
+            continue;
+        }
+        scoreShifts(column_counts, chi_squared.data());
+        shifts[column] = std::min_element(chi_squared.begin(), chi_squared.end()) - chi_squared.begin();
+    }
+    return shifts;
+}
+
+String FrequencyAnalysis::recoverKey(const String& message, uint32 key_length) const {
+    checkEnglishAlphabet();
+    // Every column is read in place from the ciphertext, so no index buffer or column copies are needed.
+    String key;
+    key.reserve(key_length);
+    for (uint32 column = 0; column < key_length; ++column) {
+        const uint8 shift = recoverShift(StridedView(message, column, key_length));
+        key += shift < alphabet_size ? Utils::convertIntToChar(shift) : '?';
+    }
+    return key;
+}
+
+void FrequencyAnalysis::checkEnglishAlphabet() const {
+    if (alphabet_size != Utils::english_alphabet_size) {
+        throw std::logic_error("Text keys need a language with the 26-letter alphabet");
+    }
+}
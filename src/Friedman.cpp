@@ -0,0 +1,195 @@
+#include "Friedman.h"
+#include "LanguageModel.h"
+#include "ThreadPool.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Key length 1 is plain monoalphabetic text and is the answer when nothing else fits.
+constexpr uint32 smallest_key_length = 2;
+
+// Stretch of text counted for every key length before moving on, small enough to stay in L1.
+constexpr datatype_size count_block_size = 1 << 12;
+
+uint32 closestKeyLength(const Vector(float64)& averages, float64 expected_ic) {
+    uint32 best_key_length = 1;
+    float64 min_ic_difference = 1.0;
+    for (datatype_size i = 0; i < averages.size(); ++i) {
+        const float64 ic_difference = std::abs(averages[i] - expected_ic);
+        if (ic_difference < min_ic_difference) {
+            min_ic_difference = ic_difference;
+            best_key_length = smallest_key_length + i;
+        }
+    }
+    return best_key_length;
+}
+
+} // namespace
+
+float64 Friedman::indexOfCoincidence(const uint32* counts, uint32 alphabet_size) {
+    float64 coincidences = 0.0;
+    float64 letters = 0.0;
+    for (uint32 letter = 0; letter < alphabet_size; ++letter) {
+        const float64 count = counts[letter];
+        coincidences += count * (count - 1.0);
+        letters += count;
+    }
+    if (letters < 2.0) {
+        return 0.0;
+    }
+    return coincidences / (letters * (letters - 1.0));
+}
+
+float64 Friedman::averageIC(const uint8* indices, datatype_size size, uint32 alphabet_size, uint32 key_length,
+                            uint32* counts) {
+    std::fill(counts, counts + key_length * (alphabet_size + 1), 0);
+    countColumns(indices, size, alphabet_size, key_length, 0, counts);
+    return averageColumns(counts, alphabet_size, key_length);
+}
+
+void Friedman::countColumns(const uint8* indices, datatype_size size, uint32 alphabet_size, uint32 key_length,
+                            uint32 first_residue, uint32* counts) {
+    const uint32 row = alphabet_size + 1;
+
+    // Walk the residue alongside the position instead of taking i % key_length.
+    uint32* column = counts + first_residue * row;
+    uint32* const end = counts + key_length * row;
+    for (datatype_size i = 0; i < size; ++i) {
+        ++column[indices[i]];
+        column += row;
+        if (column == end) {
+            column = counts;
+        }
+    }
+}
+
+float64 Friedman::averageColumns(const uint32* counts, uint32 alphabet_size, uint32 key_length) {
+    float64 total = 0.0;
+    for (uint32 residue = 0; residue < key_length; ++residue) {
+        total += indexOfCoincidence(counts + residue * (alphabet_size + 1), alphabet_size);
+    }
+    return total / key_length;
+}
+
+Vector(float64) Friedman::averageIC(const uint8* indices, datatype_size size, uint32 alphabet_size,
+                                    uint32 min_key_length, uint32 max_key_length) {
+    if (min_key_length == 0) {
+        throw std::invalid_argument("Key lengths must be positive");
+    }
+    if (max_key_length <= min_key_length) {
+        return {};
+    }
+
+    // The tables of all key lengths lie back to back in one flat array; key length L takes L rows.
+    const uint32 row = alphabet_size + 1;
+    const uint32 length_count = max_key_length - min_key_length;
+    Vector(datatype_size) offsets(length_count + 1, 0);
+    for (uint32 i = 0; i < length_count; ++i) {
+        offsets[i + 1] = offsets[i] + static_cast<datatype_size>(min_key_length + i) * row;
+    }
+    Vector(uint32) counts(offsets.back(), 0);
+
+    // One pass over the text: every block is counted for all key lengths while it is still in L1, and each
+    // length resumes at the residue where the previous block left it.
+    for (datatype_size begin = 0; begin < size; begin += count_block_size) {
+        const datatype_size length = std::min(count_block_size, size - begin);
+        for (uint32 i = 0; i < length_count; ++i) {
+            const uint32 key_length = min_key_length + i;
+            countColumns(indices + begin, length, alphabet_size, key_length, begin % key_length,
+                         counts.data() + offsets[i]);
+        }
+    }
+
+    Vector(float64) averages;
+    averages.reserve(length_count);
+    for (uint32 i = 0; i < length_count; ++i) {
+        averages.push_back(averageColumns(counts.data() + offsets[i], alphabet_size, min_key_length + i));
+    }
+    return averages;
+}
+
+uint32 Friedman::findKeyLength(const String& message, uint32 max_key_length, float64 expected_ic) {
+    Vector(uint8) indices(message.size());
+    Utils::convertLettersToIndices(message.data(), message.size(), indices.data());
+    return closestKeyLength(averageIC(indices.data(), indices.size(), Utils::english_alphabet_size,
+                                      smallest_key_length, max_key_length),
+                            expected_ic);
+}
+
+uint32 Friedman::findKeyLength(const uint8* indices, datatype_size size, uint32 max_key_length,
+                               const LanguageModel& model) {
+    return closestKeyLength(averageIC(indices, size, model.getAlphabetSize(), smallest_key_length, max_key_length),
+                            model.getExpectedIC());
+}
+
+Vector(KeyLengthCandidate) Friedman::rankKeyLengths(const uint8* indices, datatype_size size, uint32 alphabet_size,
+                                                    uint32 min_key_length, uint32 max_key_length,
+                                                    float64 expected_ic, ThreadPool& pool) {
+    if (min_key_length == 0) {
+        throw std::invalid_argument("Key lengths must be positive");
+    }
+    if (max_key_length <= min_key_length) {
+        return {};
+    }
+
+    // Split the text as well when there are too few key lengths to give every worker a few tasks.
+    const datatype_size length_count = max_key_length - min_key_length;
+    const datatype_size wanted_tasks = 4 * static_cast<datatype_size>(pool.getThreadCount());
+    const datatype_size max_chunks = std::max<datatype_size>(1, size / min_chunk_size);
+    const datatype_size chunk_count = std::clamp<datatype_size>((wanted_tasks + length_count - 1) / length_count, 1, max_chunks);
+    const datatype_size chunk_size = (size + chunk_count - 1) / chunk_count;
+    const uint32 row = alphabet_size + 1;
+
+    Vector(Vector(uint32)) partial_counts(length_count * chunk_count);
+    for (datatype_size length_index = 0; length_index < length_count; ++length_index) {
+        for (datatype_size chunk = 0; chunk < chunk_count; ++chunk) {
+            pool.submit([&, length_index, chunk] {
+                const uint32 key_length = min_key_length + length_index;
+                const datatype_size begin = std::min(size, chunk * chunk_size);
+                const datatype_size end = std::min(size, begin + chunk_size);
+                Vector(uint32)& counts = partial_counts[length_index * chunk_count + chunk];
+                counts.assign(static_cast<datatype_size>(key_length) * row, 0);
+                countColumns(indices + begin, end - begin, alphabet_size, key_length, begin % key_length, counts.data());
+            });
+        }
+    }
+    pool.wait();
+
+    Vector(KeyLengthCandidate) candidates;
+    candidates.reserve(length_count);
+    for (datatype_size length_index = 0; length_index < length_count; ++length_index) {
+        const uint32 key_length = min_key_length + length_index;
+        Vector(uint32)& merged = partial_counts[length_index * chunk_count];
+        for (datatype_size chunk = 1; chunk < chunk_count; ++chunk) {
+            const Vector(uint32)& counts = partial_counts[length_index * chunk_count + chunk];
+            for (datatype_size i = 0; i < merged.size(); ++i) {
+                merged[i] += counts[i];
+            }
+        }
+        const float64 average_ic = averageColumns(merged.data(), alphabet_size, key_length);
+        candidates.push_back({key_length, average_ic, std::abs(average_ic - expected_ic)});
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const KeyLengthCandidate& a, const KeyLengthCandidate& b) {
+        return a.score < b.score;
+    });
+    return candidates;
+}
+
+Vector(KeyLengthCandidate) Friedman::rankKeyLengths(const String& message, uint32 max_key_length, ThreadPool& pool,
+                                                    float64 expected_ic) {
+    Vector(uint8) indices(message.size());
+    Utils::convertLettersToIndices(message.data(), message.size(), indices.data());
+    return rankKeyLengths(indices.data(), indices.size(), Utils::english_alphabet_size, smallest_key_length,
+                          max_key_length, expected_ic, pool);
+}
+
+Vector(KeyLengthCandidate) Friedman::rankKeyLengths(const uint8* indices, datatype_size size,
+                                                    uint32 min_key_length, uint32 max_key_length,
+                                                    const LanguageModel& model, ThreadPool& pool) {
+    return rankKeyLengths(indices, size, model.getAlphabetSize(), min_key_length, max_key_length,
+                          model.getExpectedIC(), pool);
+}
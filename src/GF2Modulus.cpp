@@ -0,0 +1,210 @@
+#include "GF2Modulus.h"
+#include "Clmul.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Copies the bits of src from position `shift` upwards into dst.
+ */
+void extractHigh(const uint64* src, datatype_size src_size, uint32 shift, uint64* dst, datatype_size dst_size) {
+    const datatype_size word_shift = shift / 64;
+    const uint32 bit_shift = shift % 64;
+    for (datatype_size i = 0; i < dst_size; ++i) {
+        const datatype_size index = i + word_shift;
+        const uint64 low = index < src_size ? src[index] : 0;
+        const uint64 high = index + 1 < src_size ? src[index + 1] : 0;
+        dst[i] = bit_shift == 0 ? low : (low >> bit_shift) | (high << (64 - bit_shift));
+    }
+}
+
+/**
+ * @brief Computes dst ^= src * x^shift, dropping whatever lands past the end of dst.
+ */
+void xorShiftedInto(uint64* dst, datatype_size dst_size, const uint64* src, datatype_size src_size, uint32 shift) {
+    const datatype_size word_shift = shift / 64;
+    const uint32 bit_shift = shift % 64;
+    for (datatype_size i = 0; i < src_size && i + word_shift < dst_size; ++i) {
+        if (bit_shift == 0) {
+            dst[i + word_shift] ^= src[i];
+            continue;
+        }
+        dst[i + word_shift] ^= src[i] << bit_shift;
+        if (i + word_shift + 1 < dst_size) {
+            dst[i + word_shift + 1] ^= src[i] >> (64 - bit_shift);
+        }
+    }
+}
+
+/**
+ * @brief Clears every bit of buffer at and above position `bits`.
+ */
+void truncateBits(uint64* buffer, datatype_size size, uint32 bits) {
+    const datatype_size first_word = bits / 64;
+    if (first_word >= size) {
+        return;
+    }
+    if (bits % 64 != 0) {
+        buffer[first_word] &= (1ULL << (bits % 64)) - 1;
+        std::fill(buffer + first_word + 1, buffer + size, 0);
+    } else {
+        std::fill(buffer + first_word, buffer + size, 0);
+    }
+}
+
+} // namespace
+
+GF2Modulus::GF2Modulus(const GF2Polynomial& modulus) : modulus(modulus), degree(modulus.getDegree()) {
+    if (degree == 0) {
+        throw std::invalid_argument("Modulus must have a positive degree");
+    }
+    word_count = (degree + 63) / 64;
+
+    // Trinomials and pentanomials whose middle terms sit in the lower half fold down in two passes.
+    uint32 highest_low_term = 0;
+    for (uint32 i = 0; i < degree; ++i) {
+        if (modulus.getCoefficient(i)) {
+            low_terms.push_back(i);
+            highest_low_term = i;
+        }
+    }
+    sparse = low_terms.size() <= 4 && 2 * highest_low_term <= degree;
+
+    if (!sparse) {
+        // mu = floor(x^(2m) / f), by plain long division once.
+        GF2Polynomial remainder = GF2Polynomial::monomial(2 * degree);
+        GF2Polynomial quotient;
+        while (!remainder.isZero() && remainder.getDegree() >= degree) {
+            const uint32 shift = remainder.getDegree() - degree;
+            quotient.setCoefficient(shift, true);
+            remainder += modulus << shift;
+        }
+        mu = quotient.getWords();
+    }
+
+    product.assign(2 * word_count, 0);
+    high.assign(word_count, 0);
+    wide.assign(2 * word_count + 1, 0);
+    accumulator.assign(word_count, 0);
+    const datatype_size modulus_size = modulus.getWords().size();
+    clmul_scratch.assign(std::max({Clmul::multiplyScratchSize(word_count, word_count),
+                                   Clmul::multiplyScratchSize(word_count, mu.size()),
+                                   Clmul::multiplyScratchSize(word_count, modulus_size)}), 0);
+}
+
+const GF2Polynomial& GF2Modulus::getModulus() const {
+    return modulus;
+}
+
+uint32 GF2Modulus::getDegree() const {
+    return degree;
+}
+
+datatype_size GF2Modulus::getWordCount() const {
+    return word_count;
+}
+
+bool GF2Modulus::isSparse() const {
+    return sparse;
+}
+
+void GF2Modulus::toResidue(const GF2Polynomial& value, uint64* out) const {
+    const GF2Polynomial reduced = value % modulus;
+    const Vector(uint64)& words = reduced.getWords();
+    std::fill(out, out + word_count, 0);
+    std::copy(words.begin(), words.end(), out);
+}
+
+GF2Polynomial GF2Modulus::fromResidue(const uint64* residue) const {
+    return GF2Polynomial::fromWords(Vector(uint64)(residue, residue + word_count));
+}
+
+void GF2Modulus::multiply(const uint64* a, const uint64* b, uint64* out) {
+    Clmul::multiply(a, word_count, b, word_count, product.data(), clmul_scratch.data());
+    reduce(product.data(), out);
+}
+
+void GF2Modulus::square(const uint64* a, uint64* out) {
+    Clmul::square(a, word_count, product.data());
+    reduce(product.data(), out);
+}
+
+void GF2Modulus::power(const uint64* base, const uint64* exp, datatype_size exp_size, uint64* out) {
+    std::copy(base, base + word_count, accumulator.begin());
+    std::fill(out, out + word_count, 0);
+    out[0] = 1;
+
+    datatype_size top = exp_size;
+    while (top > 0 && exp[top - 1] == 0) {
+        --top;
+    }
+    for (datatype_size word = 0; word < top; ++word) {
+        uint64 bits = exp[word];
+        const uint32 width = word + 1 == top ? std::bit_width(bits) : 64;
+        for (uint32 bit = 0; bit < width; ++bit) {
+            if (bits % 2 == 1) {
+                multiply(out, accumulator.data(), out);
+            }
+            square(accumulator.data(), accumulator.data());
+            bits /= 2;
+        }
+    }
+}
+
+GF2Polynomial GF2Modulus::multiply(const GF2Polynomial& a, const GF2Polynomial& b) {
+    Vector(uint64) lhs(word_count), rhs(word_count);
+    toResidue(a, lhs.data());
+    toResidue(b, rhs.data());
+    multiply(lhs.data(), rhs.data(), lhs.data());
+    return fromResidue(lhs.data());
+}
+
+GF2Polynomial GF2Modulus::power(const GF2Polynomial& base, const Vector(uint64)& exp) {
+    Vector(uint64) residue(word_count), result(word_count);
+    toResidue(base, residue.data());
+    power(residue.data(), exp.data(), exp.size(), result.data());
+    return fromResidue(result.data());
+}
+
+void GF2Modulus::reduce(uint64* product, uint64* out) {
+    if (sparse) {
+        reduceSparse(product, out);
+    } else {
+        reduceBarrett(product, out);
+    }
+}
+
+void GF2Modulus::reduceSparse(uint64* product, uint64* out) {
+    const datatype_size product_size = 2 * word_count;
+    while (true) {
+        // x^m = (low terms of f), so H * x^m folds down to H times each low term.
+        extractHigh(product, product_size, degree, high.data(), word_count);
+        if (std::all_of(high.begin(), high.end(), [](uint64 word) { return word == 0; })) {
+            break;
+        }
+        truncateBits(product, product_size, degree);
+        for (uint32 term : low_terms) {
+            xorShiftedInto(product, product_size, high.data(), word_count, term);
+        }
+    }
+    std::copy(product, product + word_count, out);
+}
+
+void GF2Modulus::reduceBarrett(uint64* product, uint64* out) {
+    const Vector(uint64)& modulus_words = modulus.getWords();
+
+    // q = floor(floor(c / x^m) * mu / x^m) is the exact quotient for deg c < 2m.
+    extractHigh(product, 2 * word_count, degree, high.data(), word_count);
+    Clmul::multiply(high.data(), word_count, mu.data(), mu.size(), wide.data(), clmul_scratch.data());
+    extractHigh(wide.data(), word_count + mu.size(), degree, high.data(), word_count);
+
+    // r = c - q * f, of which only the low m bits can be non-zero.
+    Clmul::multiply(high.data(), word_count, modulus_words.data(), modulus_words.size(), wide.data(),
+                    clmul_scratch.data());
+    for (datatype_size i = 0; i < word_count; ++i) {
+        out[i] = product[i] ^ wide[i];
+    }
+    truncateBits(out, word_count, degree);
+}
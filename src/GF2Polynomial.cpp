@@ -0,0 +1,348 @@
+#include "GF2Polynomial.h"
+#include "Clmul.h"
+#include "GF2Modulus.h"
+#include "Math.h"
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <stdexcept>
+
+GF2Polynomial::GF2Polynomial(uint64 bits) {
+    if (bits != 0) {
+        words.push_back(bits);
+    }
+}
+
+GF2Polynomial::GF2Polynomial(const Polynomial& polynomial) {
+    const Vector(int32)& coeffs = polynomial.getCoefficients();
+    words.assign(coeffs.size() / 64 + 1, 0);
+    for (datatype_size i = 0; i < coeffs.size(); ++i) {
+        // Reducing modulo 2 is just the low bit, which is also correct for negative coefficients.
+        if (coeffs[i] & 1) {
+            words[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+    normalize();
+}
+
+GF2Polynomial GF2Polynomial::fromWords(Vector(uint64) words) {
+    GF2Polynomial result;
+    result.words = std::move(words);
+    result.normalize();
+    return result;
+}
+
+GF2Polynomial GF2Polynomial::monomial(uint32 exponent) {
+    GF2Polynomial result;
+    result.words.assign(exponent / 64 + 1, 0);
+    result.words.back() = 1ULL << (exponent % 64);
+    return result;
+}
+
+Polynomial GF2Polynomial::toPolynomial() const {
+    Vector(int32) coeffs(getDegree() + 1, 0);
+    for (uint32 i = 0; i < coeffs.size(); ++i) {
+        coeffs[i] = getCoefficient(i) ? 1 : 0;
+    }
+    return Polynomial(std::move(coeffs), Polynomial::LowToHigh{});
+}
+
+uint32 GF2Polynomial::getDegree() const {
+    if (words.empty()) {
+        return 0;
+    }
+    return (words.size() - 1) * 64 + std::bit_width(words.back()) - 1;
+}
+
+uint32 GF2Polynomial::getWeight() const {
+    uint32 weight = 0;
+    for (uint64 word : words) {
+        weight += std::popcount(word);
+    }
+    return weight;
+}
+
+bool GF2Polynomial::getCoefficient(uint32 exponent) const {
+    const datatype_size index = exponent / 64;
+    if (index >= words.size()) {
+        return false;
+    }
+    return (words[index] >> (exponent % 64)) & 1;
+}
+
+void GF2Polynomial::setCoefficient(uint32 exponent, bool value) {
+    const datatype_size index = exponent / 64;
+    if (value) {
+        if (index >= words.size()) {
+            words.resize(index + 1, 0);
+        }
+        words[index] |= 1ULL << (exponent % 64);
+    } else if (index < words.size()) {
+        words[index] &= ~(1ULL << (exponent % 64));
+        normalize();
+    }
+}
+
+const Vector(uint64)& GF2Polynomial::getWords() const {
+    return words;
+}
+
+bool GF2Polynomial::isZero() const {
+    return words.empty();
+}
+
+bool GF2Polynomial::isOne() const {
+    return words.size() == 1 && words[0] == 1;
+}
+
+String GF2Polynomial::toString() const {
+    return toPolynomial().toString();
+}
+
+GF2Polynomial& GF2Polynomial::operator+=(const GF2Polynomial& other) {
+    if (other.words.size() > words.size()) {
+        words.resize(other.words.size(), 0);
+    }
+    for (datatype_size i = 0; i < other.words.size(); ++i) {
+        words[i] ^= other.words[i];
+    }
+    normalize();
+    return *this;
+}
+
+GF2Polynomial GF2Polynomial::operator+(const GF2Polynomial& other) const {
+    GF2Polynomial result = *this;
+    result += other;
+    return result;
+}
+
+GF2Polynomial GF2Polynomial::operator*(const GF2Polynomial& other) const {
+    GF2Polynomial result;
+    if (isZero() || other.isZero()) {
+        return result;
+    }
+
+    result.words.resize(words.size() + other.words.size());
+    Clmul::multiply(words.data(), words.size(), other.words.data(), other.words.size(), result.words.data());
+    result.normalize();
+    return result;
+}
+
+GF2Polynomial GF2Polynomial::square() const {
+    GF2Polynomial result;
+    result.words.resize(2 * words.size());
+    Clmul::square(words.data(), words.size(), result.words.data());
+    result.normalize();
+    return result;
+}
+
+GF2Polynomial& GF2Polynomial::operator*=(const GF2Polynomial& other) {
+    *this = *this * other;
+    return *this;
+}
+
+GF2Polynomial& GF2Polynomial::operator%=(const GF2Polynomial& other) {
+    divide(*this, other, nullptr, this);
+    return *this;
+}
+
+GF2Polynomial GF2Polynomial::operator%(const GF2Polynomial& other) const {
+    GF2Polynomial result = *this;
+    result %= other;
+    return result;
+}
+
+void GF2Polynomial::divide(const GF2Polynomial& dividend, const GF2Polynomial& divisor,
+                           GF2Polynomial* quotient, GF2Polynomial* remainder) {
+    if (divisor.isZero()) {
+        throw std::invalid_argument("Division by zero polynomial");
+    }
+    if (&divisor == &dividend) {
+        // Moving the dividend out below would empty the divisor too.
+        if (quotient != nullptr) {
+            *quotient = GF2Polynomial(1);
+        }
+        if (remainder != nullptr) {
+            *remainder = GF2Polynomial();
+        }
+        return;
+    }
+
+    // Reducing in place, as `%=` does, needs no copy of the dividend.
+    GF2Polynomial rest = remainder == &dividend ? std::move(*remainder) : dividend;
+    GF2Polynomial result;
+    const uint32 divisor_degree = divisor.getDegree();
+    while (!rest.isZero() && rest.getDegree() >= divisor_degree) {
+        // In GF(2) the lead coefficient is always 1, so each step cancels the leading term.
+        const uint32 shift = rest.getDegree() - divisor_degree;
+        if (quotient != nullptr) {
+            result.setCoefficient(shift, true);
+        }
+        xorShifted(rest.words, divisor.words, shift);
+        rest.normalize();
+    }
+
+    if (quotient != nullptr) {
+        *quotient = std::move(result);
+    }
+    if (remainder != nullptr) {
+        *remainder = std::move(rest);
+    }
+}
+
+GF2Polynomial GF2Polynomial::operator<<(uint32 shift) const {
+    GF2Polynomial result;
+    if (isZero()) {
+        return result;
+    }
+    xorShifted(result.words, words, shift);
+    return result;
+}
+
+bool GF2Polynomial::operator==(const GF2Polynomial& other) const {
+    return words == other.words;
+}
+
+bool GF2Polynomial::operator!=(const GF2Polynomial& other) const {
+    return words != other.words;
+}
+
+GF2Polynomial GF2Polynomial::powerMod(const GF2Polynomial& base, uint64 exp, const GF2Polynomial& mod) {
+    return powerMod(base, Vector(uint64){exp}, mod);
+}
+
+GF2Polynomial GF2Polynomial::powerMod(const GF2Polynomial& base, const Vector(uint64)& exp, const GF2Polynomial& mod) {
+    if (mod.isZero()) {
+        throw std::invalid_argument("Division by zero polynomial");
+    }
+    if (mod.getDegree() == 0) {
+        return GF2Polynomial(); // Everything is 0 modulo 1.
+    }
+    return GF2Modulus(mod).power(base, exp);
+}
+
+GF2Polynomial GF2Polynomial::gcd(GF2Polynomial a, GF2Polynomial b) {
+    while (!b.isZero()) {
+        a %= b;
+        std::swap(a, b);
+    }
+    return a;
+}
+
+bool GF2Polynomial::isIrreducible() const {
+    const uint32 degree = getDegree();
+    if (degree == 0) return false;
+    if (degree == 1) return true; // x and x+1
+    if (!getCoefficient(0)) return false; // Must not be divisible by x
+    if (getWeight() % 2 == 0) return false; // Must not be divisible by x+1
+
+    const GF2Polynomial x(0b10);
+    Vector(uint64) checkpoints;
+    for (uint64 prime : Math::findPrimeFactors(degree)) {
+        checkpoints.push_back(degree / prime);
+    }
+    std::sort(checkpoints.begin(), checkpoints.end());
+
+    GF2Modulus modulus(*this);
+    Vector(uint64) x_residue(modulus.getWordCount(), 0);
+    modulus.toResidue(x, x_residue.data());
+
+    // power holds x^(2^i) mod f after the i-th squaring.
+    Vector(uint64) power = x_residue;
+    datatype_size next_checkpoint = 0;
+    for (uint32 i = 1; i <= degree; ++i) {
+        modulus.square(power.data(), power.data());
+        if (next_checkpoint < checkpoints.size() && checkpoints[next_checkpoint] == i) {
+            // f has no irreducible factor whose degree divides n/q.
+            if (!gcd(*this, modulus.fromResidue(power.data()) + x).isOne()) {
+                return false;
+            }
+            ++next_checkpoint;
+        }
+    }
+
+    return power == x_residue;
+}
+
+bool GF2Polynomial::isPrimitive() const {
+    if (!getCoefficient(0) || !isIrreducible()) {
+        return false;
+    }
+
+    const uint32 m = getDegree();
+    if (m > 64) {
+        // 2^m - 1 no longer fits in a word; when it is prime, every irreducible polynomial is primitive.
+        static const Array(uint32, 18) mersenne_exponents = {89, 107, 127, 521, 607, 1279, 2203, 2281, 3217, 4253,
+                                                            4423, 9689, 9941, 11213, 19937, 21701, 23209, 44497};
+        if (std::find(mersenne_exponents.begin(), mersenne_exponents.end(), m) != mersenne_exponents.end()) {
+            return true;
+        }
+        throw std::domain_error("Primitivity above degree 64 needs 2^m - 1 to be a Mersenne prime.");
+    }
+
+    // Irreducibility already gives x^(2^m) = x, so x^n = 1 and only the maximal proper divisors of n remain.
+    const uint64 n = m == 64 ? ~0ULL : (1ULL << m) - 1;
+    GF2Modulus modulus(*this);
+    Vector(uint64) x(modulus.getWordCount(), 0);
+    Vector(uint64) power(modulus.getWordCount(), 0);
+    modulus.toResidue(GF2Polynomial(0b10), x.data());
+    for (uint64 prime : orderPrimeFactors(m)) {
+        if (prime == n) {
+            continue;
+        }
+        const uint64 exponent = n / prime;
+        modulus.power(x.data(), &exponent, 1, power.data());
+        if (modulus.fromResidue(power.data()).isOne()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const Vector(uint64)& GF2Polynomial::orderPrimeFactors(uint32 degree) {
+    static Map(uint32, Vector(uint64)) cache;
+    static std::mutex cache_mutex;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(degree);
+    if (it == cache.end()) {
+        const uint64 n = degree == 64 ? ~0ULL : (1ULL << degree) - 1;
+        it = cache.emplace(degree, Math::findPrimeFactors(n)).first;
+    }
+    return it->second;
+}
+
+void GF2Polynomial::normalize() {
+    while (!words.empty() && words.back() == 0) {
+        words.pop_back();
+    }
+}
+
+void GF2Polynomial::xorShifted(Vector(uint64)& dst, const Vector(uint64)& src, uint32 shift) {
+    if (src.empty()) {
+        return;
+    }
+
+    const datatype_size word_shift = shift / 64;
+    const uint32 bit_shift = shift % 64;
+    const datatype_size top_bit = (src.size() - 1) * 64 + std::bit_width(src.back()) - 1 + shift;
+    const datatype_size needed = top_bit / 64 + 1;
+    if (dst.size() < needed) {
+        dst.resize(needed, 0);
+    }
+
+    if (bit_shift == 0) {
+        for (datatype_size i = 0; i < src.size(); ++i) {
+            dst[i + word_shift] ^= src[i];
+        }
+        return;
+    }
+
+    for (datatype_size i = 0; i < src.size(); ++i) {
+        dst[i + word_shift] ^= src[i] << bit_shift;
+        const uint64 carry = src[i] >> (64 - bit_shift);
+        if (carry != 0) {
+            dst[i + word_shift + 1] ^= carry;
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#include "Kasiski.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+KasiskiResult Kasiski::analyze(const String& message, uint32 min_length, uint32 max_factor) {
+    if (min_length == 0) {
+        throw std::invalid_argument("Minimum repeat length must be positive");
+    }
+    if (message.size() >= std::numeric_limits<uint32>::max()) {
+        throw std::length_error("Message is too long for 32-bit positions");
+    }
+
+    KasiskiResult result;
+    result.factor_histogram.assign(max_factor + 1, 0);
+    result.key_length = 0;
+    if (message.size() <= min_length) {
+        return result;
+    }
+
+    const Vector(uint32) suffix_array = buildSuffixArray(message);
+    const Vector(uint32) lcp = buildLcpArray(message, suffix_array);
+    const datatype_size size = suffix_array.size();
+
+    datatype_size start = 0;
+    while (start < size) {
+        // A run [start, end) of suffixes that pairwise share at least min_length characters.
+        datatype_size end = start + 1;
+        uint32 shared = std::numeric_limits<uint32>::max();
+        while (end < size && lcp[end] >= min_length) {
+            shared = std::min(shared, lcp[end]);
+            ++end;
+        }
+        if (end - start < 2) {
+            start = end;
+            continue;
+        }
+
+        Vector(uint32) positions(suffix_array.begin() + start, suffix_array.begin() + end);
+        start = end;
+
+        // If every occurrence is preceded by the same character, the run is the tail of a longer repeat
+        // with the same spacings, which has its own run.
+        bool left_extendable = positions[0] > 0;
+        for (datatype_size i = 1; left_extendable && i < positions.size(); ++i) {
+            left_extendable = positions[i] > 0 && message[positions[i] - 1] == message[positions[0] - 1];
+        }
+        if (left_extendable) {
+            continue;
+        }
+
+        std::sort(positions.begin(), positions.end());
+        for (datatype_size i = 1; i < positions.size(); ++i) {
+            addDistance(result.factor_histogram, positions[i] - positions[i - 1]);
+        }
+        result.repeats.push_back({shared, std::move(positions)});
+    }
+
+    result.key_length = estimateKeyLength(result.factor_histogram);
+    return result;
+}
+
+void Kasiski::addDistance(Vector(uint64)& histogram, uint64 distance) {
+    // Divisors come in pairs (f, distance / f) with f <= sqrt(distance), so large histograms stay cheap.
+    const uint64 limit = histogram.size() - 1;
+    for (uint64 factor = 1; factor * factor <= distance; ++factor) {
+        if (distance % factor != 0) {
+            continue;
+        }
+        const uint64 cofactor = distance / factor;
+        if (factor >= 2 && factor <= limit) {
+            ++histogram[factor];
+        }
+        if (cofactor != factor && cofactor >= 2 && cofactor <= limit) {
+            ++histogram[cofactor];
+        }
+    }
+}
+
+uint32 Kasiski::estimateKeyLength(const Vector(uint64)& histogram) {
+    uint64 best_count = 0;
+    for (datatype_size factor = 2; factor < histogram.size(); ++factor) {
+        best_count = std::max(best_count, histogram[factor]);
+    }
+    if (best_count == 0) {
+        return 0;
+    }
+
+    for (datatype_size factor = histogram.size() - 1; factor >= 2; --factor) {
+        if (histogram[factor] >= factor_tolerance * best_count) {
+            return factor;
+        }
+    }
+    return 0;
+}
+
+Vector(uint32) Kasiski::buildSuffixArray(const String& text) {
+    const datatype_size size = text.size();
+    Vector(uint32) suffix_array(size), rank(size), next_rank(size), by_second(size);
+    if (size == 0) {
+        return suffix_array;
+    }
+
+    // Rank 0 is reserved for "past the end", so it sorts before every real character.
+    Vector(uint32) counts(std::max<datatype_size>(size, 256) + 1, 0);
+    uint32 rank_count = 256;
+    Array(bool, 256) seen = {};
+    datatype_size distinct = 0;
+    for (datatype_size i = 0; i < size; ++i) {
+        rank[i] = static_cast<uint8>(text[i]) + 1;
+        by_second[i] = i;
+        if (!seen[rank[i] - 1]) {
+            seen[rank[i] - 1] = true;
+            ++distinct;
+        }
+    }
+
+    auto sortByRank = [&]() {
+        // Stable counting sort of by_second by rank into suffix_array.
+        std::fill(counts.begin(), counts.begin() + rank_count + 1, 0);
+        for (datatype_size i = 0; i < size; ++i) {
+            ++counts[rank[i]];
+        }
+        for (uint32 r = 1; r <= rank_count; ++r) {
+            counts[r] += counts[r - 1];
+        }
+        for (datatype_size i = size; i-- > 0;) {
+            suffix_array[--counts[rank[by_second[i]]]] = by_second[i];
+        }
+    };
+    sortByRank();
+
+    for (datatype_size step = 1; distinct < size; step <<= 1) {
+        // Order by the rank `step` characters ahead: the suffixes that run off the end come first, the
+        // others follow the current suffix order shifted back by `step`.
+        datatype_size filled = 0;
+        for (datatype_size i = size - std::min(step, size); i < size; ++i) {
+            by_second[filled++] = i;
+        }
+        for (datatype_size i = 0; i < size; ++i) {
+            if (suffix_array[i] >= step) {
+                by_second[filled++] = suffix_array[i] - step;
+            }
+        }
+        sortByRank();
+
+        // Suffixes with equal first and second keys share a rank.
+        auto second_key = [&](uint32 position) { return position + step < size ? rank[position + step] : 0; };
+        next_rank[suffix_array[0]] = 1;
+        uint32 current = 1;
+        for (datatype_size i = 1; i < size; ++i) {
+            const uint32 previous = suffix_array[i - 1];
+            const uint32 position = suffix_array[i];
+            if (rank[previous] != rank[position] || second_key(previous) != second_key(position)) {
+                ++current;
+            }
+            next_rank[position] = current;
+        }
+        rank.swap(next_rank);
+        rank_count = current;
+        distinct = current;
+    }
+    return suffix_array;
+}
+
+Vector(uint32) Kasiski::buildLcpArray(const String& text, const Vector(uint32)& suffix_array) {
+    const datatype_size size = suffix_array.size();
+    Vector(uint32) lcp(size, 0), inverse(size);
+    for (datatype_size i = 0; i < size; ++i) {
+        inverse[suffix_array[i]] = i;
+    }
+
+    // The common prefix with the preceding suffix shrinks by at most one from position i to i + 1.
+    uint32 length = 0;
+    for (datatype_size i = 0; i < size; ++i) {
+        if (inverse[i] == 0) {
+            length = 0;
+            continue;
+        }
+        const datatype_size previous = suffix_array[inverse[i] - 1];
+        while (i + length < size && previous + length < size && text[i + length] == text[previous + length]) {
+            ++length;
+        }
+        lcp[inverse[i]] = length;
+        if (length > 0) {
+            --length;
+        }
+    }
+    return lcp;
+}
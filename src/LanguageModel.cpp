@@ -0,0 +1,358 @@
+#include "LanguageModel.h"
+#include "Friedman.h"
+#include "Utils.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CRYPTOGRAPHY1_MMAP
+#endif
+
+namespace {
+
+constexpr Array(char, 4) file_magic = {'C', 'R', 'L', 'M'};
+constexpr uint32 file_version = 1;
+
+struct FileHeader {
+    Array(char, 4) magic;
+    uint32 version;
+    uint32 alphabet_size;
+    uint32 order_mask;
+    float64 expected_ic;
+};
+static_assert(sizeof(FileHeader) == 24, "The model header must have no padding");
+
+// Letters a-z in English text.
+const Vector(float64) english_frequencies = {
+    0.08167, 0.01492, 0.02782, 0.04253, 0.12702, 0.02228, 0.02015, 0.06094, 0.06966,
+    0.00153, 0.00772, 0.04025, 0.02406, 0.06749, 0.07507, 0.01929, 0.00095, 0.05987,
+    0.06327, 0.09056, 0.02758, 0.00978, 0.02360, 0.00150, 0.01974, 0.00074,
+};
+
+// Letters alpha-omega in modern Greek text, with final sigma counted as sigma.
+const Vector(float64) greek_frequencies = {
+    0.1140, 0.0070, 0.0180, 0.0170, 0.0840, 0.0050, 0.0500, 0.0140,
+    0.0840, 0.0420, 0.0260, 0.0340, 0.0660, 0.0040, 0.1000, 0.0430,
+    0.0430, 0.0840, 0.0880, 0.0430, 0.0080, 0.0110, 0.0020, 0.0180,
+};
+
+datatype_size tableSize(uint32 alphabet_size, uint32 order) {
+    datatype_size size = 1;
+    for (uint32 i = 0; i < order; ++i) {
+        size *= alphabet_size;
+    }
+    return size;
+}
+
+void checkAlphabetSize(uint32 alphabet_size) {
+    // Letter indices are bytes and the index alphabet_size itself marks non-letters.
+    if (alphabet_size < 2 || alphabet_size > 255) {
+        throw std::invalid_argument("Alphabet size must be between 2 and 255");
+    }
+}
+
+Vector(uint8) writeImage(uint32 alphabet_size, float64 expected_ic, uint32 order_mask,
+                         const Array(Vector(float32), LanguageModel::max_order + 1)& tables) {
+    const FileHeader header{file_magic, file_version, alphabet_size, order_mask, expected_ic};
+    datatype_size size = sizeof(header);
+    for (uint32 order = 1; order <= LanguageModel::max_order; ++order) {
+        size += tables[order].size() * sizeof(float32);
+    }
+
+    Vector(uint8) image(size);
+    std::memcpy(image.data(), &header, sizeof(header));
+    datatype_size offset = sizeof(header);
+    for (uint32 order = 1; order <= LanguageModel::max_order; ++order) {
+        std::memcpy(image.data() + offset, tables[order].data(), tables[order].size() * sizeof(float32));
+        offset += tables[order].size() * sizeof(float32);
+    }
+    return image;
+}
+
+} // namespace
+
+LanguageModel LanguageModel::load(const String& path) {
+    LanguageModel model;
+#ifdef CRYPTOGRAPHY1_MMAP
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("Failed to open language model " + path);
+    }
+    struct stat status {};
+    if (::fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        ::close(descriptor);
+        throw std::runtime_error("Language model " + path + " is empty or unreadable");
+    }
+    void* mapping = ::mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map language model " + path);
+    }
+    model.mapping = mapping;
+    model.mapping_size = status.st_size;
+    model.parse(static_cast<const uint8*>(mapping), model.mapping_size);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open language model " + path);
+    }
+    model.storage.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    model.parse(model.storage.data(), model.storage.size());
+#endif
+    return model;
+}
+
+LanguageModel LanguageModel::fromBytes(Vector(uint8) bytes) {
+    LanguageModel model;
+    model.storage = std::move(bytes);
+    model.parse(model.storage.data(), model.storage.size());
+    return model;
+}
+
+LanguageModel LanguageModel::fromFrequencies(const Vector(float64)& frequencies, float64 expected_ic) {
+    checkAlphabetSize(frequencies.size());
+    const float64 total = std::accumulate(frequencies.begin(), frequencies.end(), 0.0);
+    Array(Vector(float32), max_order + 1) tables;
+    for (float64 frequency : frequencies) {
+        if (!(frequency > 0.0)) {
+            throw std::invalid_argument("Letter frequencies must be positive");
+        }
+        tables[1].push_back(static_cast<float32>(std::log10(frequency / total)));
+    }
+    return fromBytes(writeImage(frequencies.size(), expected_ic, 1u << 1, tables));
+}
+
+const LanguageModel& LanguageModel::english() {
+    static const LanguageModel model = fromFrequencies(english_frequencies, Friedman::english_ic);
+    return model;
+}
+
+const LanguageModel& LanguageModel::greek() {
+    // The coincidence rate of a large text tends to the sum of the squared letter frequencies.
+    static const LanguageModel model = [] {
+        const float64 total = std::accumulate(greek_frequencies.begin(), greek_frequencies.end(), 0.0);
+        float64 ic = 0.0;
+        for (float64 frequency : greek_frequencies) {
+            ic += (frequency / total) * (frequency / total);
+        }
+        return fromFrequencies(greek_frequencies, ic);
+    }();
+    return model;
+}
+
+LanguageModel::LanguageModel(LanguageModel&& other) noexcept {
+    *this = std::move(other);
+}
+
+LanguageModel& LanguageModel::operator=(LanguageModel&& other) noexcept {
+    if (this != &other) {
+        release();
+        // Moving a vector keeps its buffer, so table pointers into `storage` stay valid.
+        mapping = std::exchange(other.mapping, nullptr);
+        mapping_size = std::exchange(other.mapping_size, 0);
+        storage = std::move(other.storage);
+        alphabet_size = other.alphabet_size;
+        expected_ic = other.expected_ic;
+        tables = std::exchange(other.tables, {});
+    }
+    return *this;
+}
+
+LanguageModel::~LanguageModel() {
+    release();
+}
+
+void LanguageModel::release() {
+#ifdef CRYPTOGRAPHY1_MMAP
+    if (mapping != nullptr) {
+        ::munmap(mapping, mapping_size);
+    }
+#endif
+    mapping = nullptr;
+    mapping_size = 0;
+}
+
+void LanguageModel::parse(const uint8* data, datatype_size size) {
+    FileHeader header;
+    if (size < sizeof(header)) {
+        throw std::runtime_error("Language model is truncated");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != file_magic || header.version != file_version) {
+        throw std::runtime_error("Not a language model, or an unsupported version");
+    }
+    if (header.alphabet_size < 2 || header.alphabet_size > 255 || header.order_mask == 0 ||
+        (header.order_mask & ~((2u << max_order) - 2)) != 0) {
+        throw std::runtime_error("Language model header is malformed");
+    }
+
+    datatype_size offset = sizeof(header);
+    for (uint32 order = 1; order <= max_order; ++order) {
+        if ((header.order_mask & (1u << order)) == 0) {
+            continue;
+        }
+        const datatype_size bytes = tableSize(header.alphabet_size, order) * sizeof(float32);
+        if (size - offset < bytes) {
+            throw std::runtime_error("Language model is truncated");
+        }
+        tables[order] = reinterpret_cast<const float32*>(data + offset);
+        offset += bytes;
+    }
+    if (offset != size) {
+        throw std::runtime_error("Language model has trailing data");
+    }
+    alphabet_size = header.alphabet_size;
+    expected_ic = header.expected_ic;
+}
+
+uint32 LanguageModel::getAlphabetSize() const {
+    return alphabet_size;
+}
+
+float64 LanguageModel::getExpectedIC() const {
+    return expected_ic;
+}
+
+uint32 LanguageModel::getMaxOrder() const {
+    for (uint32 order = max_order; order > 0; --order) {
+        if (tables[order] != nullptr) {
+            return order;
+        }
+    }
+    return 0;
+}
+
+const float32* LanguageModel::getTable(uint32 order) const {
+    return order <= max_order ? tables[order] : nullptr;
+}
+
+Vector(float64) LanguageModel::getLetterFrequencies() const {
+    if (tables[1] == nullptr) {
+        throw std::logic_error("Language model has no letter frequencies");
+    }
+    Vector(float64) frequencies(alphabet_size);
+    float64 total = 0.0;
+    for (uint32 letter = 0; letter < alphabet_size; ++letter) {
+        frequencies[letter] = std::pow(10.0, tables[1][letter]);
+        total += frequencies[letter];
+    }
+    for (float64& frequency : frequencies) {
+        frequency /= total;
+    }
+    return frequencies;
+}
+
+float64 LanguageModel::fitness(const uint8* indices, datatype_size size) const {
+    return fitness(indices, size, getMaxOrder());
+}
+
+float64 LanguageModel::fitness(const uint8* indices, datatype_size size, uint32 order) const {
+    const float32* table = getTable(order);
+    if (order == 0 || table == nullptr) {
+        throw std::invalid_argument("Language model does not hold this n-gram order");
+    }
+
+    float64 score = 0.0;
+    uint32 letters_in_row = 0;
+    for (datatype_size i = 0; i < size; ++i) {
+        if (indices[i] >= alphabet_size) {
+            letters_in_row = 0;
+            continue;
+        }
+        if (++letters_in_row < order) {
+            continue;
+        }
+        datatype_size index = 0;
+        for (const uint8* letter = indices + i + 1 - order; letter <= indices + i; ++letter) {
+            index = index * alphabet_size + *letter;
+        }
+        score += table[index];
+    }
+    return score;
+}
+
+LanguageModelBuilder::LanguageModelBuilder(uint32 alphabet_size, const Vector(uint32)& orders)
+    : alphabet_size(alphabet_size), order_mask(0) {
+    checkAlphabetSize(alphabet_size);
+    for (uint32 order : orders) {
+        if (order == 0 || order > LanguageModel::max_order) {
+            throw std::invalid_argument("N-gram orders must be between 1 and 4");
+        }
+        order_mask |= 1u << order;
+    }
+    if (order_mask == 0) {
+        throw std::invalid_argument("A language model needs at least one n-gram order");
+    }
+    for (uint32 order = 1; order <= LanguageModel::max_order; ++order) {
+        if (order == 1 || (order_mask & (1u << order)) != 0) {
+            counts[order].assign(tableSize(alphabet_size, order), 0);
+        }
+    }
+}
+
+void LanguageModelBuilder::addText(const uint8* indices, datatype_size size) {
+    uint32 letters_in_row = 0;
+    for (datatype_size i = 0; i < size; ++i) {
+        if (indices[i] >= alphabet_size) {
+            letters_in_row = 0;
+            continue;
+        }
+        ++letters_in_row;
+        for (uint32 order = 1; order <= LanguageModel::max_order && order <= letters_in_row; ++order) {
+            if (counts[order].empty()) {
+                continue;
+            }
+            datatype_size ngram = 0;
+            for (const uint8* letter = indices + i + 1 - order; letter <= indices + i; ++letter) {
+                ngram = ngram * alphabet_size + *letter;
+            }
+            ++counts[order][ngram];
+            ++totals[order];
+        }
+    }
+}
+
+Vector(uint8) LanguageModelBuilder::serialize() const {
+    Array(Vector(float32), LanguageModel::max_order + 1) tables;
+    for (uint32 order = 1; order <= LanguageModel::max_order; ++order) {
+        if ((order_mask & (1u << order)) == 0) {
+            continue;
+        }
+        const float64 total = std::max<float64>(totals[order], 1.0);
+        const float32 floor = static_cast<float32>(std::log10(0.01 / total));
+        tables[order].reserve(counts[order].size());
+        for (uint64 count : counts[order]) {
+            tables[order].push_back(count == 0 ? floor : static_cast<float32>(std::log10(count / total)));
+        }
+    }
+
+    float64 coincidences = 0.0;
+    for (uint64 count : counts[1]) {
+        coincidences += static_cast<float64>(count) * (static_cast<float64>(count) - 1.0);
+    }
+    const float64 letters = totals[1];
+    const float64 expected_ic = letters < 2.0 ? 0.0 : coincidences / (letters * (letters - 1.0));
+    return writeImage(alphabet_size, expected_ic, order_mask, tables);
+}
+
+LanguageModel LanguageModelBuilder::build() const {
+    return LanguageModel::fromBytes(serialize());
+}
+
+void LanguageModelBuilder::save(const String& path) const {
+    const Vector(uint8) image = serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(image.data()), image.size());
+    if (!file) {
+        throw std::runtime_error("Failed to write language model " + path);
+    }
+}
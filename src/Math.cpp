@@ -2,6 +2,7 @@
 #include <numeric>
 #include "Types.h"
 #include <vector>
+#include <algorithm>
 
 uint32 Math::findGCD(const Vector(uint32) &numbers) {
     if (numbers.empty()) {
@@ -40,4 +41,118 @@ float64 Math::average(const Vector(float64)& values) {
         sum += value;
     }
     return sum / values.size();
+}
+
+bool Math::isPrime(uint64 number) {
+    if (number < 2) {
+        return false;
+    }
+    for (uint64 prime : {2ULL, 3ULL, 5ULL, 7ULL, 11ULL, 13ULL, 17ULL, 19ULL, 23ULL, 29ULL, 31ULL, 37ULL}) {
+        if (number % prime == 0) {
+            return number == prime;
+        }
+    }
+
+    uint64 odd_part = number - 1;
+    uint32 twos = 0;
+    while (odd_part % 2 == 0) {
+        odd_part /= 2;
+        ++twos;
+    }
+
+    // These bases are enough for a deterministic answer below 3.3 * 10^24, which covers every uint64.
+    for (uint64 base : {2ULL, 3ULL, 5ULL, 7ULL, 11ULL, 13ULL, 17ULL, 19ULL, 23ULL, 29ULL, 31ULL, 37ULL}) {
+        uint64 x = powMod(base, odd_part, number);
+        if (x == 1 || x == number - 1) {
+            continue;
+        }
+        bool composite = true;
+        for (uint32 i = 1; i < twos; ++i) {
+            x = mulMod(x, x, number);
+            if (x == number - 1) {
+                composite = false;
+                break;
+            }
+        }
+        if (composite) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Vector(uint64) Math::findPrimeFactors(uint64 number) {
+    Vector(uint64) factors;
+    if (number < 2) {
+        return factors;
+    }
+
+    for (uint64 divisor = 2; divisor < 1000 && divisor <= number / divisor; ++divisor) {
+        if (number % divisor == 0) {
+            factors.push_back(divisor);
+            while (number % divisor == 0) {
+                number /= divisor;
+            }
+        }
+    }
+
+    // What is left has no factor below 1000; split it with Pollard's rho until only primes remain.
+    Vector(uint64) pending;
+    if (number > 1) {
+        pending.push_back(number);
+    }
+    while (!pending.empty()) {
+        const uint64 value = pending.back();
+        pending.pop_back();
+        if (isPrime(value)) {
+            factors.push_back(value);
+            continue;
+        }
+        const uint64 divisor = findFactorPollardRho(value);
+        pending.push_back(divisor);
+        pending.push_back(value / divisor);
+    }
+
+    std::sort(factors.begin(), factors.end());
+    factors.erase(std::unique(factors.begin(), factors.end()), factors.end());
+    return factors;
+}
+
+uint64 Math::mulMod(uint64 a, uint64 b, uint64 modulus) {
+    return static_cast<uint64>(static_cast<unsigned __int128>(a) * b % modulus);
+}
+
+uint64 Math::powMod(uint64 base, uint64 exp, uint64 modulus) {
+    uint64 result = 1 % modulus;
+    base %= modulus;
+    while (exp > 0) {
+        if (exp % 2 == 1) {
+            result = mulMod(result, base, modulus);
+        }
+        base = mulMod(base, base, modulus);
+        exp /= 2;
+    }
+    return result;
+}
+
+uint64 Math::findFactorPollardRho(uint64 number) {
+    if (number % 2 == 0) {
+        return 2;
+    }
+
+    // Pollard's rho with Floyd cycle detection, retried with a new constant if a cycle gives no factor.
+    for (uint64 constant = 1;; ++constant) {
+        uint64 x = 2;
+        uint64 y = 2;
+        uint64 divisor = 1;
+        while (divisor == 1) {
+            x = (mulMod(x, x, number) + constant) % number;
+            y = (mulMod(y, y, number) + constant) % number;
+            y = (mulMod(y, y, number) + constant) % number;
+            divisor = std::gcd(x > y ? x - y : y - x, number);
+        }
+        if (divisor != number) {
+            return divisor;
+        }
+    }
 }
\ No newline at end of file
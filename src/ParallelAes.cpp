@@ -0,0 +1,105 @@
+#include "ParallelAes.h"
+#include "AesContext.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+void checkKeyAndIv(const String& key, const String& iv) {
+    if (key.length() != AesContext::key_size) {
+        throw std::length_error("Key must be 16 bytes for AES-128.");
+    }
+    if (iv.length() != AesContext::block_size) {
+        throw std::length_error("IV must be 16 bytes for AES-128.");
+    }
+}
+
+} // namespace
+
+void ParallelAes::ctr(const String& key, const String& iv, std::span<const uint8> input, std::span<uint8> output,
+                      ThreadPool& pool) {
+    checkKeyAndIv(key, iv);
+    if (output.size() < input.size()) {
+        throw std::invalid_argument("Output buffer is too small");
+    }
+
+    const Vector(datatype_size) bounds = splitSegments(input.size(), pool.getThreadCount());
+    auto runSegment = [&key, &iv, input, output](datatype_size begin, datatype_size end) {
+        AesContext context(AesMode::CTR, key, addToCounter(iv, begin / AesContext::block_size));
+        context.process(input.data() + begin, end - begin, output.data() + begin);
+    };
+    if (bounds.size() <= 2) {
+        runSegment(0, input.size());
+        return;
+    }
+    for (datatype_size segment = 0; segment + 1 < bounds.size(); ++segment) {
+        pool.submit([&runSegment, begin = bounds[segment], end = bounds[segment + 1]] { runSegment(begin, end); });
+    }
+    pool.wait();
+}
+
+datatype_size ParallelAes::decryptCBC(const String& key, const String& iv, std::span<const uint8> input,
+                                      std::span<uint8> output, ThreadPool& pool) {
+    checkKeyAndIv(key, iv);
+    if (input.empty() || input.size() % AesContext::block_size != 0) {
+        throw std::invalid_argument("CBC ciphertext must be a positive whole number of blocks");
+    }
+    if (output.size() < input.size()) {
+        throw std::invalid_argument("Output buffer is too small");
+    }
+
+    const Vector(datatype_size) bounds = splitSegments(input.size(), pool.getThreadCount());
+    auto runSegment = [&key, &iv, input, output](datatype_size begin, datatype_size end) {
+        // A segment is chained to the last ciphertext block before it, exactly as if decryption had run through.
+        const String segment_iv = begin == 0 ? iv
+                                             : String(input.begin() + (begin - AesContext::block_size),
+                                                      input.begin() + begin);
+        AesContext context(AesMode::CBC, key, segment_iv, AesDirection::Decrypt);
+        // Padding is removed once, from the last block of the whole message, below.
+        context.setPadding(false);
+        context.process(input.data() + begin, end - begin, output.data() + begin);
+    };
+    if (bounds.size() <= 2) {
+        runSegment(0, input.size());
+    } else {
+        for (datatype_size segment = 0; segment + 1 < bounds.size(); ++segment) {
+            pool.submit([&runSegment, begin = bounds[segment], end = bounds[segment + 1]] {
+                runSegment(begin, end);
+            });
+        }
+        pool.wait();
+    }
+
+    const uint8 padding = output[input.size() - 1];
+    if (padding == 0 || padding > AesContext::block_size ||
+        std::any_of(output.begin() + (input.size() - padding), output.begin() + input.size(),
+                    [padding](uint8 byte) { return byte != padding; })) {
+        throw std::runtime_error("Failed to finalize decryption: bad padding");
+    }
+    return input.size() - padding;
+}
+
+String ParallelAes::addToCounter(const String& counter, uint64 blocks) {
+    String result = counter;
+    uint64 carry = blocks;
+    for (datatype_size i = result.size(); i-- > 0 && carry != 0;) {
+        carry += static_cast<uint8>(result[i]);
+        result[i] = static_cast<char>(carry & 0xff);
+        carry >>= 8;
+    }
+    return result;
+}
+
+Vector(datatype_size) ParallelAes::splitSegments(datatype_size size, uint32 thread_count) {
+    const datatype_size blocks = (size + AesContext::block_size - 1) / AesContext::block_size;
+    const datatype_size segment_count =
+        std::max<datatype_size>(1, std::min<datatype_size>(thread_count, size / min_segment_size));
+    const datatype_size segment_blocks = (blocks + segment_count - 1) / segment_count;
+
+    Vector(datatype_size) bounds{0};
+    while (bounds.back() < size) {
+        bounds.push_back(std::min(size, bounds.back() + segment_blocks * AesContext::block_size));
+    }
+    return bounds;
+}
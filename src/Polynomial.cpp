@@ -1,4 +1,6 @@
 #include "Polynomial.h"
+#include "GF2Polynomial.h"
+#include "Convolution.h"
 #include <iostream>
 #include <vector>
 #include <cmath>
@@ -13,118 +15,201 @@ Polynomial::Polynomial(uint32 deg, const Vector(int32)& coeffs) : degree(deg), c
     }
 }
 
-Polynomial Polynomial::operator+(const Polynomial& other) const {
-    uint32 max_degree = std::max(degree, other.degree);
-    Vector(int32) result_coeffs(max_degree + 1, 0);
-
-    for (uint32 i = 0; i <= degree; ++i) {
-        result_coeffs[i] += coefficients[i];
+Polynomial::Polynomial(Vector(int32)&& coeffs, LowToHigh) : coefficients(std::move(coeffs)) {
+    if (coefficients.empty()) {
+        coefficients.push_back(0);
     }
+    degree = coefficients.size() - 1;
+}
 
+Polynomial& Polynomial::operator+=(const Polynomial& other) {
+    if (other.degree > degree) {
+        coefficients.resize(other.degree + 1, 0);
+        degree = other.degree;
+    }
     for (uint32 i = 0; i <= other.degree; ++i) {
-        result_coeffs[i] += other.coefficients[i];
+        coefficients[i] += other.coefficients[i];
     }
+    trim();
+    return *this;
+}
 
-    uint32 new_degree = max_degree;
-    while (new_degree > 0 && result_coeffs[new_degree] == 0) {
-        new_degree--;
+Polynomial& Polynomial::operator-=(const Polynomial& other) {
+    if (other.degree > degree) {
+        coefficients.resize(other.degree + 1, 0);
+        degree = other.degree;
     }
-
-    result_coeffs.resize(new_degree + 1);
-    std::reverse(result_coeffs.begin(), result_coeffs.end());
-    return Polynomial(new_degree, result_coeffs);
+    for (uint32 i = 0; i <= other.degree; ++i) {
+        coefficients[i] -= other.coefficients[i];
+    }
+    trim();
+    return *this;
 }
 
-Polynomial Polynomial::operator-(const Polynomial& other) const {
-    uint32 max_degree = std::max(degree, other.degree);
-    Vector(int32) result_coeffs(max_degree + 1, 0);
+Polynomial& Polynomial::operator*=(const Polynomial& other) {
+    coefficients = Convolution::multiply(coefficients, other.coefficients);
+    degree += other.degree;
+    return *this;
+}
 
-    for (uint32 i = 0; i <= degree; ++i) {
-        result_coeffs[i] += coefficients[i];
+Polynomial& Polynomial::operator/=(const Polynomial& other) {
+    if (other.isZero()) {
+        throw std::invalid_argument("Division by zero polynomial");
     }
 
-    for (uint32 i = 0; i <= other.degree; ++i) {
-        result_coeffs[i] -= other.coefficients[i];
+    if (degree < other.degree) {
+        coefficients.assign(1, 0); // Quotient is 0
+        degree = 0;
+        return *this;
     }
 
-    uint32 new_degree = max_degree;
-    while (new_degree > 0 && result_coeffs[new_degree] == 0) {
-        new_degree--;
+    const uint32 quotient_degree = degree - other.degree;
+    Vector(int32) quotient_coeffs;
+    if (usesNewtonDivision(other)) {
+        quotient_coeffs = newtonQuotient(other);
+    } else {
+        longDivide(other, &quotient_coeffs);
+        quotient_coeffs.resize(quotient_degree + 1, 0);
     }
-
-    result_coeffs.resize(new_degree + 1);
-    std::reverse(result_coeffs.begin(), result_coeffs.end());
-    return Polynomial(new_degree, result_coeffs);
+    coefficients = std::move(quotient_coeffs);
+    degree = quotient_degree;
+    return *this;
 }
 
-Polynomial Polynomial::operator*(const Polynomial& other) const {
-    uint32 new_degree = degree + other.degree;
-    Vector(int32) result_coeffs(new_degree + 1, 0);
+Polynomial& Polynomial::operator%=(const Polynomial& other) {
+    if (other.isZero()) {
+        throw std::invalid_argument("Division by zero polynomial");
+    }
 
-    for (uint32 i = 0; i <= degree; ++i) {
-        for (uint32 j = 0; j <= other.degree; ++j) {
-            result_coeffs[i + j] += coefficients[i] * other.coefficients[j];
+    if (degree < other.degree) {
+        return *this; // Remainder is the dividend
+    }
+
+    if (usesNewtonDivision(other)) {
+        // r = a - q * b, of which only the terms below the divisor's degree survive.
+        const Vector(int32) product = Convolution::multiply(newtonQuotient(other), other.coefficients);
+        for (uint32 i = 0; i < other.degree; ++i) {
+            coefficients[i] = static_cast<int32>(static_cast<uint32>(coefficients[i]) - static_cast<uint32>(product[i]));
         }
+        degree = std::max(other.degree, 1u) - 1;
+        coefficients.resize(degree + 1);
+        if (other.degree == 0) {
+            coefficients[0] = 0;
+        }
+        trim();
+        return *this;
     }
 
-    std::reverse(result_coeffs.begin(), result_coeffs.end());
-    return Polynomial(new_degree, result_coeffs);
+    longDivide(other, nullptr);
+    return *this;
 }
 
-Polynomial Polynomial::operator/(const Polynomial& other) const {
-    if (other.isZero()) {
-        throw std::invalid_argument("Division by zero polynomial");
+Polynomial Polynomial::operator+(const Polynomial& other) const& {
+    // Copy the longer operand so the sum never grows the buffer.
+    if (other.degree > degree) {
+        return other + *this;
     }
+    Polynomial result = *this;
+    result += other;
+    return result;
+}
 
-    if (degree < other.degree) {
-        return Polynomial(0, {0}); // Quotient is 0
-    }
+Polynomial Polynomial::operator+(const Polynomial& other) && {
+    *this += other;
+    return std::move(*this);
+}
 
-    Vector(int32) quotient_coeffs(degree - other.degree + 1, 0);
-    Polynomial remainder = *this;
+Polynomial Polynomial::operator-(const Polynomial& other) const& {
+    Polynomial result = *this;
+    result -= other;
+    return result;
+}
 
-    while (remainder.degree >= other.degree && !remainder.isZero()) {
-        int32 lead_coeff = remainder.coefficients.back() / other.coefficients.back();
-        uint32 lead_degree = remainder.degree - other.degree;
+Polynomial Polynomial::operator-(const Polynomial& other) && {
+    *this -= other;
+    return std::move(*this);
+}
 
-        quotient_coeffs[lead_degree] = lead_coeff;
+Polynomial Polynomial::operator*(const Polynomial& other) const {
+    return Polynomial(Convolution::multiply(coefficients, other.coefficients), LowToHigh{});
+}
 
-        Vector(int32) term_coeffs(lead_degree + 1, 0);
-        term_coeffs.back() = lead_coeff;
-        std::reverse(term_coeffs.begin(), term_coeffs.end());
-        Polynomial term(lead_degree, term_coeffs);
+Polynomial Polynomial::operator/(const Polynomial& other) const {
+    Polynomial quotient = *this;
+    quotient /= other;
+    return quotient;
+}
 
-        remainder = remainder - (term * other);
-    }
+Polynomial Polynomial::operator%(const Polynomial& other) const& {
+    Polynomial remainder = *this;
+    remainder %= other;
+    return remainder;
+}
 
-    std::reverse(quotient_coeffs.begin(), quotient_coeffs.end());
-    return Polynomial(degree - other.degree, quotient_coeffs);
+Polynomial Polynomial::operator%(const Polynomial& other) && {
+    *this %= other;
+    return std::move(*this);
 }
 
-Polynomial Polynomial::operator%(const Polynomial& other) const {
-    if (other.isZero()) {
-        throw std::invalid_argument("Division by zero polynomial");
+void Polynomial::longDivide(const Polynomial& divisor, Vector(int32)* quotient) {
+    trim();
+    if (quotient != nullptr) {
+        quotient->assign(degree >= divisor.degree ? degree - divisor.degree + 1 : 1, 0);
     }
 
-    if (degree < other.degree) {
-        return *this; // Remainder is the dividend
+    const int32 divisor_lead = divisor.coefficients[divisor.degree];
+    while (degree >= divisor.degree && !(degree == 0 && coefficients[0] == 0)) {
+        const int32 lead_coeff = coefficients[degree] / divisor_lead;
+        if (lead_coeff == 0) {
+            break; // The remainder cannot be reduced any further over the integers.
+        }
+        const uint32 lead_degree = degree - divisor.degree;
+        if (quotient != nullptr) {
+            (*quotient)[lead_degree] = lead_coeff;
+        }
+
+        // remainder -= lead_coeff * x^lead_degree * divisor, wrapping like the product would.
+        for (uint32 i = 0; i <= divisor.degree; ++i) {
+            const uint32 term = static_cast<uint32>(lead_coeff) * static_cast<uint32>(divisor.coefficients[i]);
+            coefficients[lead_degree + i] = static_cast<int32>(static_cast<uint32>(coefficients[lead_degree + i]) - term);
+        }
+        trim();
     }
+}
 
-    Polynomial remainder = *this;
+void Polynomial::trim() {
+    uint32 new_degree = degree;
+    while (new_degree > 0 && coefficients[new_degree] == 0) {
+        new_degree--;
+    }
+    if (new_degree != degree) {
+        degree = new_degree;
+        coefficients.resize(degree + 1);
+    }
+}
 
-    while (remainder.degree >= other.degree && !remainder.isZero()) {
-        int32 lead_coeff = remainder.coefficients.back() / other.coefficients.back();
-        uint32 lead_degree = remainder.degree - other.degree;
+bool Polynomial::usesNewtonDivision(const Polynomial& divisor) const {
+    const int32 lead = divisor.coefficients.back();
+    return (lead == 1 || lead == -1) && degree - divisor.degree + 1 >= newton_division_threshold;
+}
 
-        Vector(int32) term_coeffs(lead_degree + 1, 0);
-        term_coeffs.back() = lead_coeff;
-        std::reverse(term_coeffs.begin(), term_coeffs.end());
-        Polynomial term(lead_degree, term_coeffs);
+Vector(int32) Polynomial::newtonQuotient(const Polynomial& divisor) const {
+    // With rev(p)(x) = x^deg(p) * p(1/x), rev(q) = rev(a) / rev(b) mod x^(n-m+1).
+    const uint32 length = degree - divisor.degree + 1;
 
-        remainder = remainder - (term * other);
+    Vector(int32) dividend_reversed(length);
+    for (uint32 i = 0; i < length; ++i) {
+        dividend_reversed[i] = coefficients[degree - i];
+    }
+    Vector(int32) divisor_reversed(std::min(length, divisor.degree + 1));
+    for (uint32 i = 0; i < divisor_reversed.size(); ++i) {
+        divisor_reversed[i] = divisor.coefficients[divisor.degree - i];
     }
 
-    return remainder;
+    Vector(int32) quotient = Convolution::multiply(dividend_reversed, Convolution::inverseSeries(divisor_reversed, length));
+    quotient.resize(length);
+    std::reverse(quotient.begin(), quotient.end());
+    return quotient;
 }
 
 uint32 Polynomial::getDegree() const {
@@ -162,7 +247,8 @@ String Polynomial::toString() const {
         if (i > 0) {
             result += "x";
             if (i > 1) {
-                result += "^" + std::to_string(i);
+                result += '^';
+                result += std::to_string(i);
             }
         }
         first_term = false;
@@ -185,131 +271,25 @@ bool Polynomial::isZero() const {
 }
 
 Polynomial Polynomial::gf2Add(const Polynomial& a, const Polynomial& b) {
-    uint32 max_degree = std::max(a.degree, b.degree);
-    Vector(int32) result_coeffs(max_degree + 1, 0);
-
-    for (uint32 i = 0; i <= a.degree; ++i) {
-        result_coeffs[i] = result_coeffs[i] ^ a.coefficients[i];
-    }
-
-    for (uint32 i = 0; i <= b.degree; ++i) {
-        result_coeffs[i] = result_coeffs[i] ^ b.coefficients[i];
-    }
-
-    uint32 new_degree = max_degree;
-    while (new_degree > 0 && result_coeffs[new_degree] == 0) {
-        new_degree--;
-    }
-
-    result_coeffs.resize(new_degree + 1);
-    std::reverse(result_coeffs.begin(), result_coeffs.end());
-    return Polynomial(new_degree, result_coeffs);
+    return (GF2Polynomial(a) + GF2Polynomial(b)).toPolynomial();
 }
 
 Polynomial Polynomial::gf2Multiply(const Polynomial& a, const Polynomial& b) {
-    uint32 new_degree = a.degree + b.degree;
-    Vector(int32) result_coeffs(new_degree + 1, 0);
-
-    for (uint32 i = 0; i <= a.degree; ++i) {
-        for (uint32 j = 0; j <= b.degree; ++j) {
-            result_coeffs[i + j] = result_coeffs[i + j] ^ (a.coefficients[i] * b.coefficients[j]);
-        }
-    }
-
-    while (new_degree > 0 && result_coeffs[new_degree] == 0) {
-        new_degree--;
-    }
-
-    result_coeffs.resize(new_degree + 1);
-    std::reverse(result_coeffs.begin(), result_coeffs.end());
-    return Polynomial(new_degree, result_coeffs);
+    return (GF2Polynomial(a) * GF2Polynomial(b)).toPolynomial();
 }
 
 Polynomial Polynomial::gf2Mod(const Polynomial& a, const Polynomial& b) {
-    if (b.isZero()) {
-        throw std::invalid_argument("Division by zero polynomial");
-    }
-
-    Polynomial remainder = a;
-
-    while (remainder.degree >= b.degree && !remainder.isZero()) {
-        uint32 lead_degree = remainder.degree - b.degree;
-        Vector(int32) term_coeffs(lead_degree + 1, 0);
-        term_coeffs.back() = 1; // In GF(2), lead coefficient is always 1
-        std::reverse(term_coeffs.begin(), term_coeffs.end());
-        Polynomial term(lead_degree, term_coeffs);
-
-        remainder = gf2Add(remainder, gf2Multiply(term, b));
-    }
-
-    return remainder;
+    return (GF2Polynomial(a) % GF2Polynomial(b)).toPolynomial();
 }
 
 bool Polynomial::gf2IsIrreducible() const {
-    if (degree == 0) return false;
-    if (coefficients[0] == 0) return false; // Must not be divisible by x
-
-    int sum_coeffs = 0;
-    for(int c : coefficients) {
-        sum_coeffs += c;
-    }
-    if (sum_coeffs % 2 == 0) return false; // Must not be divisible by x+1
-
-    // A more general implementation would check against all irreducible polys up to degree m/2
-    // For degree 5, we only need to check for irreducibles of degree 1 and 2.
-    // The checks above handle degree 1. The only irreducible of degree 2 is x^2+x+1
-    if (degree > 2) {
-        Polynomial p_x2_x_1(2, {1, 1, 1});
-        if (gf2Mod(*this, p_x2_x_1).isZero()) {
-            return false;
-        }
-    }
-    
-    // This is not a complete test for all degrees, but it covers small degrees.
-    // A full test is much more complex. For this project, we assume this is sufficient for now.
-    // For degree 5, this is sufficient if we also check for products of irreducibles of deg 1 and 2.
-    // (x+1)(x^2+x+1) = x^3+1 - covered by P(1) != 0 check
-    // A proper check for degree 5 would be against (x^2+x+1) and (x^3+x+1) and (x^3+x^2+1)
-    // But this is a good start.
-
-    return true;
+    return GF2Polynomial(*this).isIrreducible();
 }
 
 bool Polynomial::gf2IsPrimitive() const {
-    if (!gf2IsIrreducible()) {
-        return false;
-    }
-
-    uint32 m = degree;
-    uint64 n = (1ULL << m) - 1;
-
-    // Check if x^n mod P(x) == 1
-    Polynomial x(1, {1, 0});
-    Polynomial x_n = gf2Power(x, n, *this);
-
-    Polynomial one(0, {1});
-
-    if (x_n.degree != one.degree || x_n.coefficients != one.coefficients) {
-        return false;
-    }
-
-    // For a prime n (like 31), this is sufficient.
-    // For composite n, we'd also have to check that for any prime factor q of n,
-    // x^(n/q) mod P(x) != 1.
-    return true;
+    return GF2Polynomial(*this).isPrimitive();
 }
 
-Polynomial Polynomial::gf2Power(const Polynomial& base, uint32 exp, const Polynomial& mod) {
-    Polynomial res(0, {1});
-    Polynomial b = base;
-    while (exp > 0) {
-        if (exp % 2 == 1) {
-            res = gf2Multiply(res, b);
-            res = gf2Mod(res, mod);
-        }
-        b = gf2Multiply(b, b);
-        b = gf2Mod(b, mod);
-        exp /= 2;
-    }
-    return res;
+Polynomial Polynomial::gf2Power(const Polynomial& base, uint64 exp, const Polynomial& mod) {
+    return GF2Polynomial::powerMod(GF2Polynomial(base), exp, GF2Polynomial(mod)).toPolynomial();
 }
\ No newline at end of file
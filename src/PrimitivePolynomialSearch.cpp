@@ -0,0 +1,144 @@
+#include "PrimitivePolynomialSearch.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief The output of one chunk, held until every earlier chunk has been emitted.
+ */
+struct ChunkResult {
+    Vector(uint64) primitives;
+    std::exception_ptr error;
+    bool done = false;
+};
+
+/**
+ * @brief The irreducible polynomials of degree 2 to 4, packed. Degree 1 factors are covered by the
+ *        constant-term and odd-weight checks.
+ */
+constexpr Array(uint64, 6) small_irreducibles = {0b111, 0b1011, 0b1101, 0b10011, 0b11001, 0b11111};
+
+} // namespace
+
+uint64 PrimitivePolynomialSearch::enumerate(const PrimitiveSearchOptions& options, ThreadPool& pool,
+                                           const ResultCallback& on_result, const ProgressCallback& on_progress) {
+    if (options.degree == 0 || options.degree > 63) {
+        throw std::invalid_argument("Degree must be between 1 and 63.");
+    }
+    if (options.chunk_size == 0) {
+        throw std::invalid_argument("Chunk size must be non-zero.");
+    }
+
+    const uint32 degree = options.degree;
+    const uint64 total = 1ULL << (degree - 1);
+    const uint64 chunk_count = (total + options.chunk_size - 1) / options.chunk_size;
+    // Enough chunks in flight to keep every worker busy, few enough to bound the buffered results.
+    const uint64 window = std::max<uint64>(64, 8ULL * pool.getThreadCount());
+
+    Vector(ChunkResult) slots(std::min(window, chunk_count));
+    std::mutex slots_mutex;
+    std::condition_variable chunk_finished;
+    uint64 completed = 0;
+
+    auto run_chunk = [&](uint64 chunk) {
+        ChunkResult& slot = slots[chunk % slots.size()];
+        try {
+            const uint64 first = chunk * options.chunk_size;
+            const uint64 last = std::min(total, first + options.chunk_size);
+            for (uint64 index = first; index < last; ++index) {
+                // x^m + (middle terms) + 1
+                const uint64 bits = (1ULL << degree) | (index << 1) | 1;
+                if (passesFilters(bits, options) && GF2Polynomial(bits).isPrimitive()) {
+                    slot.primitives.push_back(bits);
+                }
+            }
+        } catch (...) {
+            slot.error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(slots_mutex);
+        slot.done = true;
+        completed++;
+        chunk_finished.notify_all();
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    auto last_report = start;
+    auto report = [&](uint64 tested, uint64 found) {
+        const float64 seconds = std::chrono::duration<float64>(std::chrono::steady_clock::now() - start).count();
+        on_progress({tested, total, found, seconds > 0.0 ? tested / seconds : 0.0});
+    };
+
+    uint64 next_submit = 0;
+    uint64 found = 0;
+    try {
+        for (uint64 next_emit = 0; next_emit < chunk_count; ++next_emit) {
+            while (next_submit < chunk_count && next_submit - next_emit < slots.size()) {
+                const uint64 chunk = next_submit++;
+                pool.submit([&run_chunk, chunk] { run_chunk(chunk); });
+            }
+
+            ChunkResult& slot = slots[next_emit % slots.size()];
+            {
+                std::unique_lock<std::mutex> lock(slots_mutex);
+                chunk_finished.wait(lock, [&slot] { return slot.done; });
+            }
+            if (slot.error) {
+                std::rethrow_exception(slot.error);
+            }
+
+            for (uint64 bits : slot.primitives) {
+                on_result(GF2Polynomial(bits));
+            }
+            found += slot.primitives.size();
+            slot = ChunkResult();
+
+            const auto now = std::chrono::steady_clock::now();
+            if (on_progress && now - last_report >= std::chrono::milliseconds(options.progress_interval_ms)) {
+                report(std::min(total, (next_emit + 1) * options.chunk_size), found);
+                last_report = now;
+            }
+        }
+    } catch (...) {
+        // The chunks still in flight reference this frame, so let them finish before unwinding it.
+        std::unique_lock<std::mutex> lock(slots_mutex);
+        chunk_finished.wait(lock, [&] { return completed == next_submit; });
+        throw;
+    }
+
+    if (on_progress) {
+        report(total, found);
+    }
+    return found;
+}
+
+bool PrimitivePolynomialSearch::passesFilters(uint64 bits, const PrimitiveSearchOptions& options) {
+    const uint32 weight = std::popcount(bits);
+    if (!options.weights.empty() && std::find(options.weights.begin(), options.weights.end(), weight) == options.weights.end()) {
+        return false;
+    }
+    // An even number of terms means x + 1 divides the polynomial (degree 1 is x + 1 itself).
+    if (weight % 2 == 0 && options.degree > 1) {
+        return false;
+    }
+    for (uint64 divisor : small_irreducibles) {
+        const uint32 divisor_degree = std::bit_width(divisor) - 1;
+        if (divisor_degree < options.degree && reduceWord(bits, divisor) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64 PrimitivePolynomialSearch::reduceWord(uint64 bits, uint64 divisor) {
+    const uint32 divisor_degree = std::bit_width(divisor) - 1;
+    while (bits != 0 && static_cast<uint32>(std::bit_width(bits)) - 1 >= divisor_degree) {
+        bits ^= divisor << (std::bit_width(bits) - 1 - divisor_degree);
+    }
+    return bits;
+}
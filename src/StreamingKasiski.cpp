@@ -0,0 +1,102 @@
+#include "StreamingKasiski.h"
+#include <stdexcept>
+
+namespace {
+
+// An odd multiplier with well-mixed bits; the hash is taken modulo 2^64.
+constexpr uint64 hash_base = 0x100000001B3ULL;
+
+} // namespace
+
+StreamingKasiski::StreamingKasiski(uint32 window_length, uint32 table_bits, uint32 max_factor)
+    : window_length(window_length), table_bits(table_bits), max_factor(max_factor), base_power(1) {
+    if (window_length == 0) {
+        throw std::invalid_argument("Window length must be positive");
+    }
+    if (table_bits == 0 || table_bits > 30) {
+        throw std::invalid_argument("Table size must be between 2^1 and 2^30 entries");
+    }
+    for (uint32 i = 0; i < window_length; ++i) {
+        base_power *= hash_base;
+    }
+    reset();
+}
+
+void StreamingKasiski::update(const char* data, datatype_size size) {
+    const uint32 shift = 64 - table_bits;
+    for (datatype_size i = 0; i < size; ++i) {
+        const uint8 incoming = static_cast<uint8>(data[i]);
+        const uint8 outgoing = recent[recent_index];
+        recent[recent_index] = incoming;
+        recent_index = recent_index + 1 == window_length ? 0 : recent_index + 1;
+
+        hash = hash * hash_base + incoming - outgoing * base_power;
+        ++position;
+        if (position < window_length) {
+            continue;
+        }
+
+        // The top bits are the best mixed ones of a multiplicative hash.
+        Entry& entry = table[(hash * hash_base) >> shift];
+        if (entry.end != 0 && entry.hash == hash) {
+            const uint64 distance = position - entry.end;
+            if (distance < distance_buckets) {
+                ++distance_counts[distance];
+            } else {
+                Kasiski::addDistance(far_factors, distance);
+            }
+            ++repeat_count;
+        }
+        entry.hash = hash;
+        entry.end = position;
+    }
+}
+
+void StreamingKasiski::update(const String& chunk) {
+    update(chunk.data(), chunk.size());
+}
+
+uint64 StreamingKasiski::update(std::istream& input, datatype_size chunk_size) {
+    Vector(char) buffer(chunk_size);
+    uint64 total = 0;
+    while (input) {
+        input.read(buffer.data(), buffer.size());
+        const datatype_size count = input.gcount();
+        update(buffer.data(), count);
+        total += count;
+    }
+    return total;
+}
+
+Vector(uint64) StreamingKasiski::getFactorHistogram() const {
+    Vector(uint64) histogram = far_factors;
+    for (uint64 factor = 2; factor <= max_factor; ++factor) {
+        for (uint64 distance = factor; distance < distance_buckets; distance += factor) {
+            histogram[factor] += distance_counts[distance];
+        }
+    }
+    return histogram;
+}
+
+uint32 StreamingKasiski::estimateKeyLength() const {
+    return Kasiski::estimateKeyLength(getFactorHistogram());
+}
+
+uint64 StreamingKasiski::getPosition() const {
+    return position;
+}
+
+uint64 StreamingKasiski::getRepeatCount() const {
+    return repeat_count;
+}
+
+void StreamingKasiski::reset() {
+    table.assign(datatype_size(1) << table_bits, Entry{0, 0});
+    recent.assign(window_length, 0);
+    recent_index = 0;
+    hash = 0;
+    position = 0;
+    repeat_count = 0;
+    distance_counts.assign(distance_buckets, 0);
+    far_factors.assign(max_factor + 1, 0);
+}
@@ -0,0 +1,124 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief The pool and worker index of the calling thread, so nested submissions stay local.
+ */
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local uint32 current_worker = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(uint32 thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues.reserve(thread_count);
+    for (uint32 i = 0; i < thread_count; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    threads.reserve(thread_count);
+    for (uint32 i = 0; i < thread_count; ++i) {
+        threads.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    pending_tasks++;
+
+    const uint32 index = current_pool == this ? current_worker : next_queue++ % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Counting under the state mutex means a worker about to sleep cannot miss this task.
+        std::lock_guard<std::mutex> lock(state_mutex);
+        queued_tasks++;
+    }
+    work_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    all_done.wait(lock, [this] { return pending_tasks == 0; });
+    if (first_error) {
+        std::exception_ptr error = first_error;
+        first_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+uint32 ThreadPool::getThreadCount() const {
+    return threads.size();
+}
+
+void ThreadPool::run(uint32 index) {
+    current_pool = this;
+    current_worker = index;
+
+    std::function<void()> task;
+    while (true) {
+        if (tryTakeTask(index, task)) {
+            queued_tasks--;
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                if (!first_error) {
+                    first_error = std::current_exception();
+                }
+            }
+            task = nullptr;
+
+            if (--pending_tasks == 0) {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                all_done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state_mutex);
+        work_available.wait(lock, [this] { return stopping || queued_tasks > 0; });
+        if (stopping && queued_tasks <= 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::tryTakeTask(uint32 index, std::function<void()>& task) {
+    {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (uint32 offset = 1; offset < queues.size(); ++offset) {
+        WorkerQueue& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -80,6 +80,43 @@ char Utils::convertIntToChar(uint8 i, const String& charset) {
 }
 
 
+void Utils::convertLettersToIndices(const char* text, datatype_size size, uint8* out) {
+    // Setting bit 5 lowercases ASCII letters, and only letters land in 'a'-'z' afterwards.
+    auto toIndex = [](char c) -> uint8 {
+        const uint8 index = static_cast<uint8>((static_cast<uint8>(c) | 0x20) - 'a');
+        return index < english_alphabet_size ? index : english_alphabet_size;
+    };
+
+    // Fixed-size blocks through a local buffer let the compiler use full vector registers without
+    // runtime alias checks.
+    constexpr datatype_size block = 32;
+    datatype_size i = 0;
+    for (; i + block <= size; i += block) {
+        Array(uint8, block) indices;
+        for (datatype_size j = 0; j < block; ++j) {
+            indices[j] = toIndex(text[i + j]);
+        }
+        std::copy(indices.begin(), indices.end(), out + i);
+    }
+    for (; i < size; ++i) {
+        out[i] = toIndex(text[i]);
+    }
+}
+
+void Utils::countLetters(const StridedView& text, uint32* counts) {
+    for (char c : text) {
+        const uint8 index = static_cast<uint8>((static_cast<uint8>(c) | 0x20) - 'a');
+        ++counts[index < english_alphabet_size ? index : english_alphabet_size];
+    }
+}
+
+void Utils::convertGreekLettersToIndices(const wide_char* text, datatype_size size, uint8* out) {
+    for (datatype_size i = 0; i < size; ++i) {
+        const int8 letter = convertGreekCharToInt(text[i]);
+        out[i] = letter > 0 ? letter - 1 : greek_alphabet_size;
+    }
+}
+
 Vector(uint8) Utils::getDigits(const uint32 &number) {
     if (number == 0) {
         return {0};
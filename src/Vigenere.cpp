@@ -0,0 +1,163 @@
+#include "Vigenere.h"
+#include <stdexcept>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define CRYPTOGRAPHY1_X86_SIMD 1
+#endif
+
+namespace {
+
+constexpr uint8 alphabet_size = 26;
+
+/**
+ * @brief Offsets one byte: letters are lowercased and shifted by `offset` (0-26), other bytes are kept.
+ */
+inline char offsetByte(char c, uint8 offset) {
+    const uint8 index = static_cast<uint8>((static_cast<uint8>(c) | 0x20) - 'a');
+    if (index >= alphabet_size) {
+        return c;
+    }
+    const uint8 shifted = index + offset;
+    return static_cast<char>('a' + (shifted >= alphabet_size ? shifted - alphabet_size : shifted));
+}
+
+void offsetScalar(const char* input, datatype_size size, const uint8* offsets, uint32 key_length, uint32 residue,
+                  char* output) {
+    for (datatype_size i = 0; i < size; ++i) {
+        output[i] = offsetByte(input[i], offsets[residue]);
+        if (++residue == key_length) {
+            residue = 0;
+        }
+    }
+}
+
+Vector(uint8) keyShifts(const String& key) {
+    Vector(uint8) shifts(key.size());
+    for (datatype_size i = 0; i < key.size(); ++i) {
+        const uint8 index = static_cast<uint8>((static_cast<uint8>(key[i]) | 0x20) - 'a');
+        // A key character that is not a letter counts as -1, like Utils::convertCharToInt.
+        shifts[i] = index < alphabet_size ? index : alphabet_size - 1;
+    }
+    return shifts;
+}
+
+#ifdef CRYPTOGRAPHY1_X86_SIMD
+/**
+ * @brief Advances the key position by one block; the repeated offsets cover the block from any residue.
+ */
+inline uint32 advance(uint32 residue, uint32 step, uint32 key_length) {
+    residue += step;
+    return residue < key_length ? residue : residue % key_length;
+}
+
+__attribute__((target("sse2")))
+void offsetSse2(const char* input, datatype_size size, const uint8* offsets, uint32 key_length, uint32 residue,
+                char* output) {
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i first_letter = _mm_set1_epi8('a');
+    const __m128i last_index = _mm_set1_epi8(alphabet_size - 1);
+    const __m128i wrap = _mm_set1_epi8(alphabet_size);
+
+    datatype_size i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i text = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m128i offset = _mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets + residue));
+        const __m128i index = _mm_sub_epi8(_mm_or_si128(text, case_bit), first_letter);
+        const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(index, last_index), index);
+        // Sums of 26 or more wrap; below 26, subtracting 26 underflows to a larger byte and min keeps the sum.
+        __m128i shifted = _mm_add_epi8(index, offset);
+        shifted = _mm_min_epu8(shifted, _mm_sub_epi8(shifted, wrap));
+        const __m128i letters = _mm_add_epi8(shifted, first_letter);
+        const __m128i result = _mm_or_si128(_mm_and_si128(is_letter, letters), _mm_andnot_si128(is_letter, text));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+        residue = advance(residue, 16, key_length);
+    }
+    offsetScalar(input + i, size - i, offsets, key_length, residue, output + i);
+}
+
+__attribute__((target("avx2")))
+void offsetAvx2(const char* input, datatype_size size, const uint8* offsets, uint32 key_length, uint32 residue,
+                char* output) {
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i first_letter = _mm256_set1_epi8('a');
+    const __m256i last_index = _mm256_set1_epi8(alphabet_size - 1);
+    const __m256i wrap = _mm256_set1_epi8(alphabet_size);
+
+    datatype_size i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i text = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i offset = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + residue));
+        const __m256i index = _mm256_sub_epi8(_mm256_or_si256(text, case_bit), first_letter);
+        const __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(index, last_index), index);
+        __m256i shifted = _mm256_add_epi8(index, offset);
+        shifted = _mm256_min_epu8(shifted, _mm256_sub_epi8(shifted, wrap));
+        const __m256i letters = _mm256_add_epi8(shifted, first_letter);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_blendv_epi8(text, letters, is_letter));
+        residue = advance(residue, 32, key_length);
+    }
+    offsetScalar(input + i, size - i, offsets, key_length, residue, output + i);
+}
+#endif
+
+} // namespace
+
+Vigenere::Vigenere(const String& key) : Vigenere(keyShifts(key).data(), key.size()) {
+}
+
+Vigenere::Vigenere(const uint8* shifts, uint32 key_length) : key_length(key_length) {
+    if (key_length == 0) {
+        throw std::invalid_argument("Vigenere key must not be empty");
+    }
+    Vector(uint8) encipher_shifts(shifts, shifts + key_length);
+    Vector(uint8) decipher_shifts(key_length);
+    for (uint32 i = 0; i < key_length; ++i) {
+        if (shifts[i] >= alphabet_size) {
+            throw std::invalid_argument("Vigenere shifts must be between 0 and 25");
+        }
+        decipher_shifts[i] = alphabet_size - shifts[i];
+    }
+    encipher_offsets = repeatOffsets(encipher_shifts);
+    decipher_offsets = repeatOffsets(decipher_shifts);
+}
+
+uint32 Vigenere::getKeyLength() const {
+    return key_length;
+}
+
+void Vigenere::encipher(const char* input, datatype_size size, char* output, uint64 position) const {
+    static const Kernel kernel = selectKernel();
+    kernel(input, size, encipher_offsets.data(), key_length, position % key_length, output);
+}
+
+void Vigenere::decipher(const char* input, datatype_size size, char* output, uint64 position) const {
+    static const Kernel kernel = selectKernel();
+    kernel(input, size, decipher_offsets.data(), key_length, position % key_length, output);
+}
+
+bool Vigenere::hasAvx2Support() {
+#ifdef CRYPTOGRAPHY1_X86_SIMD
+    return selectKernel() == offsetAvx2;
+#else
+    return false;
+#endif
+}
+
+Vigenere::Kernel Vigenere::selectKernel() {
+#ifdef CRYPTOGRAPHY1_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return offsetAvx2;
+    }
+    return offsetSse2;
+#else
+    return offsetScalar;
+#endif
+}
+
+Vector(uint8) Vigenere::repeatOffsets(const Vector(uint8)& offsets) {
+    Vector(uint8) repeated(offsets.size() + block_size);
+    for (datatype_size i = 0; i < repeated.size(); ++i) {
+        repeated[i] = offsets[i % offsets.size()];
+    }
+    return repeated;
+}